@@ -0,0 +1,312 @@
+#include "binarysnapshot.h"
+#include "persistenceservice.h"
+
+#include <QCborValue>
+#include <QDebug>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonDocument>
+#include <QSettings>
+#include <QtEndian>
+#include <memory>
+
+namespace {
+    // magic + format version + schema tag + schema version
+    constexpr qint64 RecordCountOffset = 4 + 2 + 4 + 2;
+
+    // Filled during static initialisation, read-only afterwards
+    QHash<quint32, BinarySnapshot::RecordDecoder>& typedDecoders() {
+        static QHash<quint32, BinarySnapshot::RecordDecoder> decoders;
+        return decoders;
+    }
+}
+
+bool BinarySnapshot::registerTypedSchema(quint32 schemaTag, RecordDecoder decoder) {
+    typedDecoders().insert(schemaTag, decoder);
+    return true;
+}
+
+BinarySnapshot::Writer::Writer(quint32 schemaTag, quint16 schemaVersion, const QString& rootKey)
+    : stream(&buffer, QIODevice::WriteOnly)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << Magic << FormatVersion << schemaTag << schemaVersion << quint32(0) << rootKey;
+}
+
+QDataStream& BinarySnapshot::Writer::beginRecord() {
+    recordStart = stream.device()->pos();
+    stream << quint32(0);
+    return stream;
+}
+
+void BinarySnapshot::Writer::endRecord() {
+    if (recordStart < 0) {
+        return;
+    }
+
+    const qint64 end = stream.device()->pos();
+    qToBigEndian(static_cast<quint32>(end - recordStart - 4),
+                 reinterpret_cast<uchar*>(buffer.data()) + recordStart);
+    recordStart = -1;
+    ++recordCount;
+}
+
+void BinarySnapshot::Writer::appendJsonRecord(const QJsonObject& object) {
+    const QByteArray cbor = QCborValue::fromJsonValue(object).toCbor();
+    beginRecord().writeRawData(cbor.constData(), cbor.size());
+    endRecord();
+}
+
+QByteArray BinarySnapshot::Writer::finish() {
+    qToBigEndian(recordCount, reinterpret_cast<uchar*>(buffer.data()) + RecordCountOffset);
+    return buffer;
+}
+
+BinarySnapshot::Reader::Reader(const QString& filePath)
+    : file(filePath)
+{
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = QString("Failed to open snapshot file: %1").arg(file.errorString());
+        return;
+    }
+
+    size = file.size();
+    data = file.map(0, size);
+    if (!data) {
+        fallbackData = file.readAll();
+        data = reinterpret_cast<const uchar*>(fallbackData.constData());
+        size = fallbackData.size();
+    }
+
+    QByteArray header = QByteArray::fromRawData(reinterpret_cast<const char*>(data), size);
+    QDataStream stream(header);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 formatVersion = 0;
+    stream >> magic >> formatVersion >> tag >> version >> count >> key;
+
+    if (stream.status() != QDataStream::Ok || magic != Magic) {
+        error = "Not a snapshot file";
+        return;
+    }
+    if (formatVersion != FormatVersion) {
+        error = QString("Unsupported snapshot format version %1").arg(formatVersion);
+        return;
+    }
+
+    offset = stream.device()->pos();
+    valid = true;
+}
+
+bool BinarySnapshot::Reader::nextRecord(const uchar*& record, quint32& recordSize) {
+    if (!valid || offset + 4 > size) {
+        return false;
+    }
+
+    const quint32 length = qFromBigEndian<quint32>(data + offset);
+    if (offset + 4 + length > size) {
+        error = "Truncated snapshot record";
+        valid = false;
+        return false;
+    }
+
+    record = data + offset + 4;
+    recordSize = length;
+    offset += 4 + length;
+    return true;
+}
+
+bool BinarySnapshot::Reader::nextJsonRecord(QJsonObject& object) {
+    const uchar* record = nullptr;
+    quint32 recordSize = 0;
+    if (!nextRecord(record, recordSize)) {
+        return false;
+    }
+
+    const QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char*>(record), recordSize);
+    object = QCborValue::fromCbor(bytes).toJsonValue().toObject();
+    return true;
+}
+
+QString BinarySnapshot::binaryPathFor(const QString& jsonPath) {
+    QString path = jsonPath;
+    if (path.endsWith(".json")) {
+        path.chop(5);
+    }
+    return path + ".bin";
+}
+
+bool BinarySnapshot::isPreferred(const QString& jsonPath) {
+    const QFileInfo binaryInfo(binaryPathFor(jsonPath));
+    if (!binaryInfo.exists()) {
+        return false;
+    }
+
+    const QFileInfo jsonInfo(jsonPath);
+    return !jsonInfo.exists() || binaryInfo.lastModified() >= jsonInfo.lastModified();
+}
+
+bool BinarySnapshot::isEnabled() {
+    static const bool enabled = QSettings().value("storage/binarySnapshots", false).toBool();
+    return enabled;
+}
+
+QByteArray BinarySnapshot::fromJsonArray(const QJsonArray& array, const QString& rootKey) {
+    Writer writer(JsonRecordsSchema, 1, rootKey);
+    for (const QJsonValue& value : array) {
+        writer.appendJsonRecord(value.toObject());
+    }
+    return writer.finish();
+}
+
+bool BinarySnapshot::readJsonArray(const QString& binaryPath, QJsonArray& array, QString& errorMessage) {
+    Reader reader(binaryPath);
+    if (!reader.isValid()) {
+        errorMessage = reader.errorString();
+        return false;
+    }
+    QJsonArray records;
+    QJsonObject object;
+    if (reader.schemaTag() == JsonRecordsSchema) {
+        while (reader.nextJsonRecord(object)) {
+            records.append(object);
+        }
+    } else {
+        const RecordDecoder decoder = typedDecoders().value(reader.schemaTag(), nullptr);
+        if (!decoder) {
+            errorMessage = "Snapshot uses an unknown typed schema and cannot be read as JSON records";
+            return false;
+        }
+
+        const uchar* record = nullptr;
+        quint32 size = 0;
+        while (reader.nextRecord(record, size)) {
+            if (decoder(record, size, object)) {
+                records.append(object);
+            }
+        }
+    }
+    if (!reader.isValid()) {
+        errorMessage = reader.errorString();
+        return false;
+    }
+
+    array = records;
+    return true;
+}
+
+bool BinarySnapshot::readJsonArrayIfPreferred(const QString& jsonPath, QJsonArray& array) {
+    if (!isPreferred(jsonPath)) {
+        return false;
+    }
+
+    QString errorMessage;
+    if (!readJsonArray(binaryPathFor(jsonPath), array, errorMessage)) {
+        qWarning() << "Ignoring binary snapshot for" << jsonPath << ":" << errorMessage;
+        return false;
+    }
+    return true;
+}
+
+void BinarySnapshot::scheduleJsonArrayWrites(const QString& jsonPath, std::function<QJsonArray()> build,
+                                             const QString& rootKey, bool withBinary) {
+    // Both jobs run on the persistence thread; whichever runs first builds the array once.
+    // If a newer snapshot replaces one job, the other still builds on its own.
+    struct Shared {
+        std::function<QJsonArray()> build;
+        QJsonArray array;
+        bool built = false;
+
+        const QJsonArray& get() {
+            if (!built) {
+                array = build();
+                build = nullptr;
+                built = true;
+            }
+            return array;
+        }
+    };
+    auto shared = std::make_shared<Shared>();
+    shared->build = std::move(build);
+
+    PersistenceService::instance().scheduleWrite(jsonPath, [shared, rootKey]() {
+        const QJsonArray& array = shared->get();
+        const QJsonDocument doc = rootKey.isEmpty()
+            ? QJsonDocument(array)
+            : QJsonDocument(QJsonObject{{rootKey, array}});
+        return doc.toJson(QJsonDocument::Indented);
+    });
+
+    if (withBinary && isEnabled()) {
+        PersistenceService::instance().scheduleWrite(binaryPathFor(jsonPath), [shared, rootKey]() {
+            return fromJsonArray(shared->get(), rootKey);
+        });
+    }
+}
+
+bool BinarySnapshot::convertJsonToBinary(const QString& jsonPath, QString& errorMessage) {
+    QFile file(jsonPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = QString("Failed to open file: %1").arg(file.errorString());
+        return false;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    file.close();
+    if (parseError.error != QJsonParseError::NoError) {
+        errorMessage = QString("JSON parse error: %1").arg(parseError.errorString());
+        return false;
+    }
+
+    QJsonArray array;
+    QString rootKey;
+    if (doc.isArray()) {
+        array = doc.array();
+    } else {
+        const QJsonObject root = doc.object();
+        if (root.size() != 1 || !root.begin().value().isArray()) {
+            errorMessage = "Only arrays or objects holding a single array can be converted";
+            return false;
+        }
+        rootKey = root.begin().key();
+        array = root.begin().value().toArray();
+    }
+
+    QFile output(binaryPathFor(jsonPath));
+    if (!output.open(QIODevice::WriteOnly)) {
+        errorMessage = QString("Failed to open file for writing: %1").arg(output.errorString());
+        return false;
+    }
+    output.write(fromJsonArray(array, rootKey));
+    output.close();
+    return true;
+}
+
+bool BinarySnapshot::convertBinaryToJson(const QString& binaryPath, QString& errorMessage) {
+    QJsonArray array;
+    if (!readJsonArray(binaryPath, array, errorMessage)) {
+        return false;
+    }
+
+    const QString rootKey = Reader(binaryPath).rootKey();
+    const QJsonDocument doc = rootKey.isEmpty()
+        ? QJsonDocument(array)
+        : QJsonDocument(QJsonObject{{rootKey, array}});
+
+    QString jsonPath = binaryPath;
+    if (jsonPath.endsWith(".bin")) {
+        jsonPath.chop(4);
+    }
+    jsonPath += ".json";
+
+    QFile output(jsonPath);
+    if (!output.open(QIODevice::WriteOnly)) {
+        errorMessage = QString("Failed to open file for writing: %1").arg(output.errorString());
+        return false;
+    }
+    output.write(doc.toJson(QJsonDocument::Indented));
+    output.close();
+    return true;
+}
@@ -0,0 +1,99 @@
+#ifndef BINARYSNAPSHOT_H
+#define BINARYSNAPSHOT_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <functional>
+
+// Compact binary companion of the JSON data files ("bookings.json" -> "bookings.bin").
+//
+// Layout (QDataStream, big endian):
+//   quint32 magic, quint16 format version, quint32 schema tag, quint16 schema version,
+//   quint32 record count, QString root key,
+//   then per record: quint32 byte length followed by the record bytes.
+//
+// Records either use a typed schema owned by a data manager or the generic JsonRecords
+// schema, where each record is a CBOR-encoded JSON object. The length prefix lets a
+// reader skip fields appended by newer schema versions.
+class BinarySnapshot {
+public:
+    static constexpr quint32 Magic = 0x46465053;             // "FFPS"
+    static constexpr quint16 FormatVersion = 1;
+    static constexpr quint32 JsonRecordsSchema = 0x4A534F4E; // "JSON"
+
+    class Writer {
+    public:
+        Writer(quint32 schemaTag, quint16 schemaVersion, const QString& rootKey = QString());
+
+        QDataStream& beginRecord();
+        void endRecord();
+        void appendJsonRecord(const QJsonObject& object);
+        QByteArray finish();
+
+    private:
+        QByteArray buffer;
+        QDataStream stream;
+        qint64 recordStart = -1;
+        quint32 recordCount = 0;
+    };
+
+    class Reader {
+    public:
+        explicit Reader(const QString& filePath);
+
+        bool isValid() const { return valid; }
+        const QString& errorString() const { return error; }
+        quint32 schemaTag() const { return tag; }
+        quint16 schemaVersion() const { return version; }
+        quint32 recordCount() const { return count; }
+        const QString& rootKey() const { return key; }
+
+        // Record bytes point into the memory-mapped file and stay valid while the reader lives
+        bool nextRecord(const uchar*& record, quint32& size);
+        bool nextJsonRecord(QJsonObject& object);
+
+    private:
+        QFile file;
+        QByteArray fallbackData;
+        const uchar* data = nullptr;
+        qint64 size = 0;
+        qint64 offset = 0;
+        bool valid = false;
+        QString error;
+        quint32 tag = 0;
+        quint16 version = 0;
+        quint32 count = 0;
+        QString key;
+    };
+
+    // Decodes one record of a typed schema into its JSON form; owners register theirs so
+    // readJsonArray and the converter also handle typed snapshots. Returns false to skip.
+    using RecordDecoder = bool (*)(const uchar* record, quint32 size, QJsonObject& object);
+    static bool registerTypedSchema(quint32 schemaTag, RecordDecoder decoder);
+
+    static QString binaryPathFor(const QString& jsonPath);
+    // True when the binary companion exists and is at least as new as the JSON file
+    static bool isPreferred(const QString& jsonPath);
+    // Opt-in through the "storage/binarySnapshots" setting
+    static bool isEnabled();
+
+    // Generic JsonRecords snapshots of a JSON array (optionally wrapped as {rootKey: [...]})
+    static QByteArray fromJsonArray(const QJsonArray& array, const QString& rootKey = QString());
+    static bool readJsonArray(const QString& binaryPath, QJsonArray& array, QString& errorMessage);
+    static bool readJsonArrayIfPreferred(const QString& jsonPath, QJsonArray& array);
+    // Writes jsonPath and, when enabled and withBinary is set, its binary companion from one
+    // array that build produces on the persistence thread; build must only touch data it owns
+    static void scheduleJsonArrayWrites(const QString& jsonPath, std::function<QJsonArray()> build,
+                                        const QString& rootKey = QString(), bool withBinary = true);
+
+    // Converters between a JSON data file and its binary companion; JSON is always converted
+    // to JsonRecords, binary snapshots with a registered typed schema are decoded back
+    static bool convertJsonToBinary(const QString& jsonPath, QString& errorMessage);
+    static bool convertBinaryToJson(const QString& binaryPath, QString& errorMessage);
+};
+
+#endif // BINARYSNAPSHOT_H
@@ -7,6 +7,34 @@
 #include <QDebug>
 #include <QStandardPaths>
 #include <QCoreApplication>
+#include "persistenceservice.h"
+#include "binarysnapshot.h"
+#include <QMetaObject>
+#include <algorithm>
+#include <utility>
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Flushes and syncs an open file to disk
+bool syncFile(QFile& file) {
+    if (!file.flush()) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+const QString CompactionSequenceKey = QStringLiteral("compactionSequence");
+
+} // namespace
 
 ClassDataManager::ClassDataManager(QObject* parent)
     : QObject(parent) {
@@ -20,6 +48,7 @@ ClassDataManager::ClassDataManager(QObject* parent)
 #endif
 
     dataDir = projectDir + "/project code/Data";
+    classIds.load(dataDir + "/id_allocators.json");
 
     QFile classesFile(dataDir + "/classes.json");
     if (!classesFile.exists()) {
@@ -28,8 +57,24 @@ ClassDataManager::ClassDataManager(QObject* parent)
         classesFile.close();
     }
 
+    attendanceLog.setFileName(dataDir + "/attendance_log.jsonl");
+    compactingAttendanceLogPath = dataDir + "/attendance_log.compacting.jsonl";
+
     initializeFromFile();
     scheduleMonthlySessions();
+
+    // Keep the data dirty if a background save of classes.json fails
+    PersistenceService& persistence = PersistenceService::instance();
+    connect(&persistence, &PersistenceService::writeFinished, this,
+            [this](const QString& filePath, bool success) {
+                if (!success && filePath == QDir(dataDir).filePath("classes.json")) {
+                    dataModified = true;
+                }
+                if (!success && filePath == QDir(dataDir).filePath("attendance.json")) {
+                    attendanceSnapshotFailed = true;
+                }
+            });
+    connect(&persistence, &PersistenceService::barrierReached, this, &ClassDataManager::onPersistenceBarrier);
 }
 
 ClassDataManager::~ClassDataManager() {
@@ -40,6 +85,28 @@ void ClassDataManager::handleApplicationClosing() {
     if (dataModified) {
         saveToFile();
     }
+
+    commitAttendanceLog();
+    if (attendanceLogEntries > 0) {
+        compactAttendanceLog();
+    }
+
+    if (PersistenceService::instance().flush() && !attendanceSnapshotFailed) {
+        QFile::remove(compactingAttendanceLogPath);
+    }
+    attendanceLog.close();
+}
+
+void ClassDataManager::onPersistenceBarrier(quint64 ticket) {
+    if (ticket != attendanceCompactionTicket) {
+        return;
+    }
+
+    // attendance.json now holds everything that was parked
+    if (!attendanceSnapshotFailed) {
+        QFile::remove(compactingAttendanceLogPath);
+    }
+    attendanceSnapshotFailed = false;
 }
 
 bool ClassDataManager::initializeFromFile() {
@@ -50,23 +117,36 @@ bool ClassDataManager::initializeFromFile() {
     }
 
     classesById.clear();
+    classesByDate.clear();
 
     for (const QJsonValue& classValue : classesArray) {
         Class gymClass = jsonToClass(classValue.toObject());
         classesById[gymClass.getId()] = gymClass;
+        classIds.observe(gymClass.getId());
+        indexSessions(gymClass);
     }
 
+    loadAttendanceRecords();
+    loadMonthlyReports();
+
+    // Parked entries from an unfinished compaction are older than the live log
+    QFile compactingLog(compactingAttendanceLogPath);
+    attendanceLogEntries = 0;
+    replayAttendanceLog(compactingLog);
+    replayAttendanceLog(attendanceLog);
+
     return true;
 }
 
 bool ClassDataManager::saveToFile() {
-    QJsonArray classesArray;
+    std::vector<Class> classes;
+    classes.reserve(classesById.size());
     for (const auto& pair : classesById) {
-        classesArray.append(classToJson(pair.second));
+        classes.push_back(pair.second);
     }
 
     QString errorMessage;
-    bool success = writeClassesToFile(classesArray, errorMessage);
+    bool success = writeClassesToFile(std::move(classes), errorMessage);
     if (!success) {
         return false;
     }
@@ -85,6 +165,7 @@ bool ClassDataManager::addClass(const Class& gymClass, QString& errorMessage) {
     int newId = generateClassId();
     newClass.setId(newId);
     classesById[newId] = newClass;
+    indexSessions(newClass);
     dataModified = true;
     return true;
 }
@@ -100,7 +181,9 @@ bool ClassDataManager::updateClass(const Class& gymClass, QString& errorMessage)
         return false;
     }
 
-    classesById[gymClass.getId()] = gymClass;
+    unindexSessions(it->second);
+    it->second = gymClass;
+    indexSessions(gymClass);
     dataModified = true;
     return true;
 }
@@ -112,6 +195,7 @@ bool ClassDataManager::deleteClass(int classId, QString& errorMessage) {
         return false;
     }
 
+    unindexSessions(it->second);
     classesById.erase(it);
     dataModified = true;
     return true;
@@ -146,14 +230,40 @@ QVector<Class> ClassDataManager::getClassesByCoach(const QString& coachName) con
 
 QVector<Class> ClassDataManager::getClassesByDate(const QDate& date) const {
     QVector<Class> result;
-    for (const auto& pair : classesById) {
-        if (pair.second.hasSessionOnDate(date)) {
-            result.append(pair.second);
+    auto dayIt = classesByDate.find(date);
+    if (dayIt == classesByDate.end()) {
+        return result;
+    }
+
+    result.reserve(static_cast<int>(dayIt->second.size()));
+    for (int classId : dayIt->second) {
+        auto classIt = classesById.find(classId);
+        if (classIt != classesById.end()) {
+            result.append(classIt->second);
         }
     }
     return result;
 }
 
+void ClassDataManager::indexSessions(const Class& gymClass) {
+    for (const QDate& date : gymClass.getSessions()) {
+        classesByDate[date].insert(gymClass.getId());
+    }
+}
+
+void ClassDataManager::unindexSessions(const Class& gymClass) {
+    for (const QDate& date : gymClass.getSessions()) {
+        auto dayIt = classesByDate.find(date);
+        if (dayIt == classesByDate.end()) {
+            continue;
+        }
+        dayIt->second.erase(gymClass.getId());
+        if (dayIt->second.empty()) {
+            classesByDate.erase(dayIt);
+        }
+    }
+}
+
 bool ClassDataManager::addToWaitlist(int classId, int memberId, bool isVIP, QString& errorMessage) {
     auto it = classesById.find(classId);
     if (it == classesById.end()) {
@@ -248,6 +358,9 @@ bool ClassDataManager::addSession(int classId, const QDate& date, QString& error
 
     Class& gymClass = it->second;
     gymClass.addSession(date);
+    if (date.isValid()) {
+        classesByDate[date].insert(classId);
+    }
     dataModified = true;
     return true;
 }
@@ -261,6 +374,13 @@ bool ClassDataManager::removeSession(int classId, const QDate& date, QString& er
 
     Class& gymClass = it->second;
     gymClass.removeSession(date);
+    auto dayIt = classesByDate.find(date);
+    if (dayIt != classesByDate.end()) {
+        dayIt->second.erase(classId);
+        if (dayIt->second.empty()) {
+            classesByDate.erase(dayIt);
+        }
+    }
     dataModified = true;
     return true;
 }
@@ -268,16 +388,8 @@ bool ClassDataManager::removeSession(int classId, const QDate& date, QString& er
 QVector<QDate> ClassDataManager::getClassSessions(int classId) const {
     auto it = classesById.find(classId);
     if (it != classesById.end()) {
-        std::queue<QDate> sessions = it->second.getSessions();
-        QVector<QDate> result;
-
-        std::queue<QDate> tempQueue = sessions;
-        while (!tempQueue.empty()) {
-            result.append(tempQueue.front());
-            tempQueue.pop();
-        }
-
-        return result;
+        const std::vector<QDate>& sessions = it->second.getSessions();
+        return QVector<QDate>(sessions.begin(), sessions.end());
     }
     return QVector<QDate>();
 }
@@ -402,6 +514,11 @@ int ClassDataManager::getEnrolledCount(int classId) const {
 }
 
 QJsonArray ClassDataManager::readClassesFromFile(QString& errorMessage) const {
+    QJsonArray snapshotArray;
+    if (BinarySnapshot::readJsonArrayIfPreferred(QDir(dataDir).filePath("classes.json"), snapshotArray)) {
+        return snapshotArray;
+    }
+
     QFile file(QDir(dataDir).filePath("classes.json"));
     if (!file.open(QIODevice::ReadOnly)) {
         errorMessage = "Could not open classes file for reading";
@@ -420,16 +537,15 @@ QJsonArray ClassDataManager::readClassesFromFile(QString& errorMessage) const {
     return doc.array();
 }
 
-bool ClassDataManager::writeClassesToFile(const QJsonArray& classes, QString& errorMessage) const {
-    QFile file(QDir(dataDir).filePath("classes.json"));
-    if (!file.open(QIODevice::WriteOnly)) {
-        errorMessage = "Could not open classes file for writing";
-        return false;
-    }
-
-    QJsonDocument doc(classes);
-    file.write(doc.toJson());
-    file.close();
+bool ClassDataManager::writeClassesToFile(std::vector<Class> classes, QString& errorMessage) const {
+    Q_UNUSED(errorMessage);
+    BinarySnapshot::scheduleJsonArrayWrites(QDir(dataDir).filePath("classes.json"), [classes = std::move(classes)]() {
+        QJsonArray classesArray;
+        for (const Class& gymClass : classes) {
+            classesArray.append(classToJson(gymClass));
+        }
+        return classesArray;
+    });
     return true;
 }
 
@@ -446,12 +562,8 @@ QJsonObject ClassDataManager::classToJson(const Class& gymClass) {
     json["numOfEnrolled"] = static_cast<int>(enrolledMembersSet.size());
 
     QJsonArray sessionsArray;
-    std::queue<QDate> sessions = gymClass.getSessions();
-    std::queue<QDate> tempQueue = sessions;
-
-    while (!tempQueue.empty()) {
-        sessionsArray.append(tempQueue.front().toString(Qt::ISODate));
-        tempQueue.pop();
+    for (const QDate& date : gymClass.getSessions()) {
+        sessionsArray.append(date.toString(Qt::ISODate));
     }
 
     json["sessions"] = sessionsArray;
@@ -520,14 +632,8 @@ Class ClassDataManager::jsonToClass(const QJsonObject& json) {
     return gymClass;
 }
 
-int ClassDataManager::generateClassId() const {
-    int maxId = 0;
-    for (const auto& pair : classesById) {
-        if (pair.first > maxId) {
-            maxId = pair.first;
-        }
-    }
-    return maxId + 1;
+int ClassDataManager::generateClassId() {
+    return classIds.next();
 }
 
 bool ClassDataManager::recordAttendance(int classId, int memberId, const QDate& date, bool attended, double amountPaid, QString& errorMessage) {
@@ -543,89 +649,213 @@ bool ClassDataManager::recordAttendance(int classId, int memberId, const QDate&
     record.attended = attended;
     record.amountPaid = amountPaid;
 
-    attendanceRecords.push_back(record);
-    dataModified = true;
+    attendanceRecords.append(record);
+
+    QByteArray line = QJsonDocument(attendanceRecordToJson(record)).toJson(QJsonDocument::Compact);
+    line.append('\n');
 
-    return saveAttendanceRecords();
+    // The first check-in of a burst schedules the commit; the rest ride along with it
+    if (pendingAttendanceLines.isEmpty()) {
+        QMetaObject::invokeMethod(this, "commitAttendanceLog", Qt::QueuedConnection);
+    }
+    pendingAttendanceLines.append(line);
+
+    return true;
 }
 
-QVector<AttendanceRecord> ClassDataManager::getAttendanceRecords(int classId, const QDate& startDate, const QDate& endDate) const {
-    QVector<AttendanceRecord> result;
-    for (const auto& record : attendanceRecords) {
-        if (record.classId == classId &&
-            record.date >= startDate &&
-            record.date <= endDate) {
-            result.append(record);
+void ClassDataManager::commitAttendanceLog() {
+    if (pendingAttendanceLines.isEmpty()) {
+        return;
+    }
+
+    const int committedEntries = pendingAttendanceLines.count('\n');
+    const QByteArray lines = std::exchange(pendingAttendanceLines, QByteArray());
+
+    bool written = attendanceLog.isOpen() || attendanceLog.open(QIODevice::WriteOnly | QIODevice::Append);
+    if (written) {
+        const qint64 committedSize = attendanceLog.size();
+        written = attendanceLog.write(lines) == lines.size() && syncFile(attendanceLog);
+        if (!written) {
+            // Never leave a torn line for later appends to follow
+            attendanceLog.resize(committedSize);
         }
     }
-    return result;
+
+    if (written) {
+        attendanceLogEntries += committedEntries;
+    }
+
+    // A failed append or sync is covered by writing a full snapshot instead
+    if (!written || attendanceLogEntries >= AttendanceCompactionThreshold) {
+        compactAttendanceLog();
+    }
 }
 
-int ClassDataManager::getAttendanceCount(int classId, const QDate& date) const {
-    int count = 0;
-    for (const auto& record : attendanceRecords) {
-        if (record.classId == classId &&
-            record.date == date &&
-            record.attended) {
-            count++;
+void ClassDataManager::compactAttendanceLog() {
+    attendanceLog.close();
+    attendanceLogEntries = 0;
+
+    if (attendanceLog.exists()) {
+        if (!QFile::exists(compactingAttendanceLogPath)) {
+            QFile::rename(attendanceLog.fileName(), compactingAttendanceLogPath);
+        } else if (attendanceLog.open(QIODevice::ReadOnly)) {
+            // A previous compaction is still in flight: keep its entries and add ours after them
+            QByteArray pending = attendanceLog.readAll();
+            attendanceLog.close();
+
+            QFile compactingLog(compactingAttendanceLogPath);
+            if (compactingLog.open(QIODevice::WriteOnly | QIODevice::Append)) {
+                const qint64 parkedSize = compactingLog.size();
+                if (compactingLog.write(pending) == pending.size() && compactingLog.flush()) {
+                    attendanceLog.remove();
+                } else {
+                    compactingLog.resize(parkedSize);
+                }
+                compactingLog.close();
+            }
         }
     }
-    return count;
+
+    // Everything parked so far is in the snapshot below. If the marker cannot be written
+    // the parked entries are replayed on top of it, which duplicates rather than loses them.
+    ++attendanceCompactionSequence;
+    if (QFile::exists(compactingAttendanceLogPath) && !appendCompactionMarker(attendanceCompactionSequence)) {
+        qDebug() << "Failed to mark the parked attendance log";
+    }
+
+    saveAttendanceRecords();
+    attendanceCompactionTicket = PersistenceService::instance().scheduleBarrier();
 }
 
-double ClassDataManager::getClassRevenue(int classId, const QDate& startDate, const QDate& endDate) const {
-    double revenue = 0.0;
-    for (const auto& record : attendanceRecords) {
-        if (record.classId == classId &&
-            record.date >= startDate &&
-            record.date <= endDate) {
-            revenue += record.amountPaid;
+bool ClassDataManager::replayAttendanceLog(QFile& file) {
+    if (!file.exists()) {
+        return true;
+    }
+
+    if (!file.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    // Records since the last compaction marker. A marker the loaded snapshot covers means
+    // they are already in attendance.json; records after the last marker never are.
+    QVector<AttendanceRecord> segment;
+    qint64 validSize = 0;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty()) {
+            validSize = file.pos();
+            continue;
         }
+
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(line, &parseError);
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+            // Torn trailing write from an interrupted commit; cut it so appends stay readable
+            file.resize(validSize);
+            break;
+        }
+        validSize = file.pos();
+
+        const QJsonObject json = doc.object();
+        if (json.contains(CompactionSequenceKey)) {
+            const qint64 sequence = json.value(CompactionSequenceKey).toInteger();
+            if (sequence > attendanceSnapshotSequence) {
+                for (const AttendanceRecord& record : segment) {
+                    attendanceRecords.append(record);
+                }
+            }
+            segment.clear();
+            attendanceCompactionSequence = std::max(attendanceCompactionSequence, sequence);
+            continue;
+        }
+
+        segment.append(jsonToAttendanceRecord(json));
+        attendanceLogEntries++;
+    }
+    file.close();
+
+    for (const AttendanceRecord& record : segment) {
+        attendanceRecords.append(record);
+    }
+    return true;
+}
+
+bool ClassDataManager::appendCompactionMarker(qint64 sequence) {
+    QFile compactingLog(compactingAttendanceLogPath);
+    if (!compactingLog.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
     }
-    return revenue;
+
+    QJsonObject marker;
+    marker[CompactionSequenceKey] = sequence;
+    QByteArray line = QJsonDocument(marker).toJson(QJsonDocument::Compact);
+    line.append('\n');
+
+    const qint64 parkedSize = compactingLog.size();
+    if (compactingLog.write(line) != line.size() || !syncFile(compactingLog)) {
+        compactingLog.resize(parkedSize);
+        return false;
+    }
+    return true;
+}
+
+QVector<AttendanceRecord> ClassDataManager::getAttendanceRecords(int classId, const QDate& startDate, const QDate& endDate) const {
+    return attendanceRecords.records(classId, startDate, endDate);
+}
+
+int ClassDataManager::getAttendanceCount(int classId, const QDate& date) const {
+    return attendanceRecords.attendedCount(classId, date);
+}
+
+double ClassDataManager::getClassRevenue(int classId, const QDate& startDate, const QDate& endDate) const {
+    return attendanceRecords.revenue(classId, startDate, endDate);
 }
 
 MonthlyReport ClassDataManager::generateMonthlyReport(const QDate& month) const {
+    const QDate monthStart(month.year(), month.month(), 1);
+    const AttendanceStore::Partition* partition = attendanceRecords.partitionFor(month.year(), month.month());
+    if (partition) {
+        return reportFromPartition(monthStart, *partition);
+    }
+
+    auto archivedIt = monthlyReports.find(monthStart);
+    if (archivedIt != monthlyReports.end()) {
+        return archivedIt->second;
+    }
+
     MonthlyReport report;
-    report.month = month;
+    report.month = monthStart;
     report.totalActiveMembers = 0;
     report.totalClassesHeld = 0;
     report.totalAttendance = 0;
     report.totalRevenue = 0.0;
+    return report;
+}
 
-    QDate startDate(month.year(), month.month(), 1);
-    QDate endDate = startDate.addMonths(1).addDays(-1);
+MonthlyReport ClassDataManager::reportFromPartition(const QDate& month, const AttendanceStore::Partition& partition) const {
+    MonthlyReport report;
+    report.month = month;
+    report.totalActiveMembers = static_cast<int>(partition.attendanceByMember.size());
+    report.totalClassesHeld = 0;
+    report.totalAttendance = 0;
+    report.totalRevenue = 0.0;
 
-    std::set<int> activeMembers;
+    // Names are resolved here so renamed classes report under their current name
     QMap<QString, int> attendanceByClass;
     QMap<QString, double> revenueByClass;
-
-    for (const auto& classPair : classesById) {
-        const Class& gymClass = classPair.second;
-        attendanceByClass[gymClass.getClassName()] = 0;
-        revenueByClass[gymClass.getClassName()] = 0.0;
-    }
-
-    for (const auto& classPair : classesById) {
-        const Class& gymClass = classPair.second;
-        QString className = gymClass.getClassName();
-
-        QVector<AttendanceRecord> classRecords = getAttendanceRecords(gymClass.getId(), startDate, endDate);
-
-        if (!classRecords.isEmpty()) {
-            report.totalClassesHeld++;
-
-            for (const auto& record : classRecords) {
-                if (record.attended) {
-                    attendanceByClass[className]++;
-                    revenueByClass[className] += record.amountPaid;
-                    activeMembers.insert(record.memberId);
-
-                    report.totalAttendance++;
-                    report.totalRevenue += record.amountPaid;
-                }
-            }
+    for (const auto& totalsPair : partition.classTotals) {
+        auto classIt = classesById.find(totalsPair.first);
+        if (classIt == classesById.end()) {
+            continue;
         }
+
+        const QString& className = classIt->second.getClassName();
+        const AttendanceStore::Partition::ClassTotals& totals = totalsPair.second;
+        report.totalClassesHeld++;
+        report.totalAttendance += totals.attended;
+        report.totalRevenue += totals.revenue;
+        attendanceByClass[className] += totals.attended;
+        revenueByClass[className] += totals.revenue;
     }
 
     for (auto it = attendanceByClass.begin(); it != attendanceByClass.end(); ++it) {
@@ -640,98 +870,43 @@ MonthlyReport ClassDataManager::generateMonthlyReport(const QDate& month) const
         }
     }
 
-    report.totalActiveMembers = static_cast<int>(activeMembers.size());
-
-    QString errorMsg;
-    saveMonthlyReport(report, errorMsg);
-
     return report;
 }
 
 bool ClassDataManager::saveMonthlyReport(const MonthlyReport& report, QString& errorMessage) const {
-
-    QVector<MonthlyReport> existingReports = getMonthlyReports(QDate(1970, 1, 1), QDate(2100, 12, 31));
-
-    for (int i = 0; i < existingReports.size(); ++i) {
-        if (existingReports[i].month.year() == report.month.year() &&
-            existingReports[i].month.month() == report.month.month()) {
-            existingReports.removeAt(i);
-            break;
-        }
-    }
-
-    existingReports.append(report);
-
-    QFile file(QDir(dataDir).filePath("monthly_reports.json"));
-    if (!file.open(QIODevice::WriteOnly)) {
-        errorMessage = "Could not open monthly reports file for writing";
-        return false;
-    }
-
-    QJsonArray reportsArray;
-    for (const MonthlyReport& r : existingReports) {
-        reportsArray.append(monthlyReportToJson(r));
-    }
-
-    QJsonDocument doc(reportsArray);
-    if (file.write(doc.toJson()) == -1) {
-        errorMessage = "Failed to write to monthly reports file";
-        file.close();
+    if (!report.month.isValid()) {
+        errorMessage = "Invalid report month";
         return false;
     }
 
-    file.close();
-    return true;
+    const QDate monthStart(report.month.year(), report.month.month(), 1);
+    MonthlyReport archived = report;
+    archived.month = monthStart;
+    monthlyReports[monthStart] = archived;
+    return saveMonthlyReports();
 }
 
 QVector<MonthlyReport> ClassDataManager::getMonthlyReports(const QDate& startDate, const QDate& endDate) const {
-    QVector<MonthlyReport> result;
-    QFile file(QDir(dataDir).filePath("monthly_reports.json"));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-
-        if (!file.exists()) {
-            file.open(QIODevice::WriteOnly);
-            file.write("[]");
-            file.close();
-            return result;
-        }
-        return result;
+    // Months with attendance come from the live aggregates, the archive covers the rest
+    std::map<QDate, MonthlyReport> reports;
+    for (auto it = monthlyReports.lower_bound(startDate); it != monthlyReports.end() && it->first <= endDate; ++it) {
+        reports[it->first] = it->second;
     }
 
-    QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
-    file.close();
+    attendanceRecords.forEachPartition(startDate, endDate,
+                                       [this, &reports](const QDate& month, const AttendanceStore::Partition& partition) {
+        reports[month] = reportFromPartition(month, partition);
+    });
 
-    if (parseError.error != QJsonParseError::NoError) {
-        qDebug() << "Error parsing monthly reports:" << parseError.errorString();
-        return result;
-    }
-
-    if (!doc.isArray()) {
-        qDebug() << "Monthly reports file does not contain a JSON array";
-        return result;
-    }
-
-    QJsonArray reportsArray = doc.array();
-    for (const QJsonValue& value : reportsArray) {
-        if (!value.isObject()) continue;
-
-        MonthlyReport report = jsonToMonthlyReport(value.toObject());
-        if (report.month >= startDate && report.month <= endDate) {
-            result.append(report);
-        }
+    QVector<MonthlyReport> result;
+    result.reserve(static_cast<int>(reports.size()));
+    for (const auto& pair : reports) {
+        result.append(pair.second);
     }
-
-    std::sort(result.begin(), result.end(),
-              [](const MonthlyReport& a, const MonthlyReport& b) {
-                  return a.month < b.month;
-              });
-
     return result;
 }
 
-QJsonObject ClassDataManager::attendanceRecordToJson(const AttendanceRecord& record) const {
+QJsonObject ClassDataManager::attendanceRecordToJson(const AttendanceRecord& record) {
     QJsonObject json;
     json["classId"] = record.classId;
     json["memberId"] = record.memberId;
@@ -803,42 +978,97 @@ MonthlyReport ClassDataManager::jsonToMonthlyReport(const QJsonObject& json) {
     return report;
 }
 
-bool ClassDataManager::loadAttendanceRecords() {
-    QFile file(QDir(dataDir).filePath("attendance.json"));
+bool ClassDataManager::loadMonthlyReports() {
+    monthlyReports.clear();
+
+    QFile file(QDir(dataDir).filePath("monthly_reports.json"));
     if (!file.open(QIODevice::ReadOnly)) {
+        return !file.exists();
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    file.close();
+
+    if (parseError.error != QJsonParseError::NoError) {
+        qDebug() << "Error parsing monthly reports:" << parseError.errorString();
         return false;
     }
 
-    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
     if (!doc.isArray()) {
+        qDebug() << "Monthly reports file does not contain a JSON array";
         return false;
     }
 
-    attendanceRecords.clear();
-    QJsonArray recordsArray = doc.array();
-    for (const QJsonValue& value : recordsArray) {
-        attendanceRecords.push_back(jsonToAttendanceRecord(value.toObject()));
+    for (const QJsonValue& value : doc.array()) {
+        if (!value.isObject()) continue;
+
+        MonthlyReport report = jsonToMonthlyReport(value.toObject());
+        if (report.month.isValid()) {
+            monthlyReports[report.month] = report;
+        }
+    }
+
+    return true;
+}
+
+bool ClassDataManager::saveMonthlyReports() const {
+    QJsonArray reportsArray;
+    for (const auto& pair : monthlyReports) {
+        reportsArray.append(monthlyReportToJson(pair.second));
     }
 
+    PersistenceService::instance().scheduleWrite(QDir(dataDir).filePath("monthly_reports.json"),
+                                                 QJsonDocument(reportsArray));
     return true;
 }
 
-bool ClassDataManager::saveAttendanceRecords() const {
+bool ClassDataManager::loadAttendanceRecords() {
     QFile file(QDir(dataDir).filePath("attendance.json"));
-    if (!file.open(QIODevice::WriteOnly)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         return false;
     }
 
+    // Snapshots from before compaction sequences are a bare array
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
     QJsonArray recordsArray;
-    for (const auto& record : attendanceRecords) {
-        recordsArray.append(attendanceRecordToJson(record));
+    if (doc.isArray()) {
+        recordsArray = doc.array();
+        attendanceSnapshotSequence = 0;
+    } else if (doc.isObject()) {
+        const QJsonObject snapshot = doc.object();
+        recordsArray = snapshot.value("records").toArray();
+        attendanceSnapshotSequence = snapshot.value(CompactionSequenceKey).toInteger();
+    } else {
+        return false;
+    }
+    attendanceCompactionSequence = attendanceSnapshotSequence;
+
+    attendanceRecords.clear();
+    for (const QJsonValue& value : recordsArray) {
+        attendanceRecords.append(jsonToAttendanceRecord(value.toObject()));
     }
 
-    file.write(QJsonDocument(recordsArray).toJson());
-    file.close();
     return true;
 }
 
+void ClassDataManager::saveAttendanceRecords() const {
+    // The columns are copied as they are; building the JSON happens on the persistence thread
+    PersistenceService::instance().scheduleWrite(QDir(dataDir).filePath("attendance.json"),
+                                                 [records = attendanceRecords,
+                                                  sequence = attendanceCompactionSequence]() {
+        QJsonArray recordsArray;
+        records.forEachRecord([&recordsArray](const AttendanceRecord& record) {
+            recordsArray.append(attendanceRecordToJson(record));
+        });
+
+        QJsonObject snapshot;
+        snapshot[CompactionSequenceKey] = sequence;
+        snapshot["records"] = recordsArray;
+        return QJsonDocument(snapshot).toJson();
+    });
+}
+
 bool ClassDataManager::scheduleClassesForMonth(const QDate& month, QString& errorMessage) {
     QDate firstDay(month.year(), month.month(), 1);
     QDate lastDay = firstDay.addMonths(1).addDays(-1);
@@ -879,7 +1109,7 @@ bool ClassDataManager::scheduleClassesForMonth(const QDate& month, QString& erro
 }
 
 void ClassDataManager::scheduleMonthlySessions() {
-    QDate today = QDate::currentDate();
+    QDate today = timeLogicInstance.getCurrentTime().date();
     QDate firstOfMonth(today.year(), today.month(), 1);
     for (auto& pair : classesById) {
         Class& gymClass = pair.second;
@@ -891,4 +1121,10 @@ void ClassDataManager::scheduleMonthlySessions() {
         }
     }
     dataModified = true;
+
+    // Run again when the simulated clock reaches the next month
+    SimulationScheduler& scheduler = SimulationScheduler::instance();
+    scheduler.cancel(monthlySessionsEvent);
+    monthlySessionsEvent = scheduler.scheduleAt(QDateTime(firstOfMonth.addMonths(1), QTime(0, 0)), this,
+                                                [this]() { scheduleMonthlySessions(); });
 }
\ No newline at end of file
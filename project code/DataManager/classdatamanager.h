@@ -3,20 +3,16 @@
 
 
 #include "../Model/Gym/class.h"
+#include "../Model/Gym/attendancestore.h"
 #include "../DataManager/memberdatamanager.h"
+#include "../DataManager/idallocator.h"
 #include <QString>
 #include <QVector>
 #include <unordered_map>
+#include <map>
+#include <set>
 #include <QDate>
-
-// Structure to store attendance data
-struct AttendanceRecord {
-    int classId;
-    int memberId;
-    QDate date;
-    bool attended;
-    double amountPaid;
-};
+#include <QFile>
 
 // Structure for monthly report
 struct MonthlyReport {
@@ -84,25 +80,59 @@ public:
     // Dependency injection
     void setMemberDataManager(MemberDataManager* memberManager) { memberDataManager = memberManager; }
 
+private slots:
+    void commitAttendanceLog();
+    void onPersistenceBarrier(quint64 ticket);
+
 private:
     QString dataDir;
     std::unordered_map<int, Class> classesById;
+    IdAllocator classIds{"classes"};
+    std::map<QDate, std::set<int>> classesByDate;   // Session date -> ids of classes meeting that day
     bool dataModified = false;
-    std::vector<AttendanceRecord> attendanceRecords;
-    std::vector<MonthlyReport> monthlyReports;
+    AttendanceStore attendanceRecords;
+    // Reports saved with saveMonthlyReport(), keyed by the first day of the month. Months
+    // that have attendance are always answered from the store's running totals instead.
+    mutable std::map<QDate, MonthlyReport> monthlyReports;
     MemberDataManager* memberDataManager = nullptr;
+    SimulationScheduler::EventId monthlySessionsEvent = 0;
+
+    // Append-only attendance log on top of the attendance.json snapshot. Check-ins are
+    // buffered and committed together (one write, one fsync) from the event loop; past
+    // AttendanceCompactionThreshold entries the log is parked in compactingAttendanceLogPath
+    // and folded into the snapshot by the persistence thread.
+    //
+    // Every compaction gets the next sequence number. It is written into attendance.json and,
+    // before that snapshot is scheduled, appended as a marker line to the parked log; on
+    // load a parked segment is skipped only if the snapshot's sequence covers its marker.
+    static constexpr int AttendanceCompactionThreshold = 500;
+    QFile attendanceLog;
+    QString compactingAttendanceLogPath;
+    QByteArray pendingAttendanceLines;
+    int attendanceLogEntries = 0;
+    quint64 attendanceCompactionTicket = 0;
+    qint64 attendanceCompactionSequence = 0;
+    qint64 attendanceSnapshotSequence = 0;         // As loaded from attendance.json
+    bool attendanceSnapshotFailed = false;
 
     QJsonArray readClassesFromFile(QString& errorMessage) const;
-    bool writeClassesToFile(const QJsonArray& classes, QString& errorMessage) const;
+    // The JSON is built from these copies on the persistence thread
+    bool writeClassesToFile(std::vector<Class> classes, QString& errorMessage) const;
     static QJsonObject classToJson(const Class& gymClass);
     static Class jsonToClass(const QJsonObject& json);
-    [[nodiscard]] int generateClassId() const;
-    QJsonObject attendanceRecordToJson(const AttendanceRecord& record) const;
+    int generateClassId();
+    void indexSessions(const Class& gymClass);
+    void unindexSessions(const Class& gymClass);
+    static QJsonObject attendanceRecordToJson(const AttendanceRecord& record);
     static AttendanceRecord jsonToAttendanceRecord(const QJsonObject& json);
     QJsonObject monthlyReportToJson(const MonthlyReport& report) const;
     static MonthlyReport jsonToMonthlyReport(const QJsonObject& json);
+    MonthlyReport reportFromPartition(const QDate& month, const AttendanceStore::Partition& partition) const;
     bool loadAttendanceRecords();
-    bool saveAttendanceRecords() const;
+    void saveAttendanceRecords() const;
+    bool replayAttendanceLog(QFile& file);
+    void compactAttendanceLog();
+    bool appendCompactionMarker(qint64 sequence);
     bool scheduleClassesForMonth(const QDate& month, QString& errorMessage);
     bool loadMonthlyReports();
     bool saveMonthlyReports() const;
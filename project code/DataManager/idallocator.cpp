@@ -0,0 +1,76 @@
+#include "idallocator.h"
+#include "persistenceservice.h"
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace {
+
+// Marks of every entity per file, so each write can carry all of them
+QMutex marksMutex;
+QHash<QString, QJsonObject> marksByFile;
+
+QJsonObject& marksFor(const QString& filePath) {
+    auto it = marksByFile.find(filePath);
+    if (it == marksByFile.end()) {
+        QJsonObject marks;
+        QFile file(filePath);
+        if (file.open(QIODevice::ReadOnly)) {
+            marks = QJsonDocument::fromJson(file.readAll()).object();
+        }
+        it = marksByFile.insert(filePath, marks);
+    }
+    return it.value();
+}
+
+} // namespace
+
+IdAllocator::IdAllocator(const QString& entity)
+    : entity(entity)
+{
+}
+
+void IdAllocator::load(const QString& path) {
+    filePath = path;
+
+    QMutexLocker locker(&marksMutex);
+    observe(marksFor(filePath).value(entity).toInt());
+}
+
+void IdAllocator::observe(int id) {
+    int current = last.load();
+    while (id > current && !last.compare_exchange_weak(current, id)) {
+    }
+}
+
+int IdAllocator::next() {
+    return reserve(1);
+}
+
+int IdAllocator::reserve(int count) {
+    if (count <= 0) {
+        return 0;
+    }
+
+    const int first = last.fetch_add(count) + 1;
+    persist(first + count - 1);
+    return first;
+}
+
+void IdAllocator::persist(int mark) const {
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(&marksMutex);
+    QJsonObject& marks = marksFor(filePath);
+    // Concurrent reservations may finish out of order; the file only ever moves up
+    if (marks.value(entity).toInt() >= mark) {
+        return;
+    }
+    marks[entity] = mark;
+    PersistenceService::instance().scheduleWrite(filePath, QJsonDocument(marks));
+}
@@ -0,0 +1,37 @@
+#ifndef IDALLOCATOR_H
+#define IDALLOCATOR_H
+
+#include <QString>
+#include <atomic>
+
+// Hands out ids for one entity type from a high-water mark instead of scanning the
+// records for their maximum on every insert.
+//
+// The mark is seeded once on load (the persisted value, raised by every loaded id
+// passed to observe) and then only moves up. It is persisted through the
+// PersistenceService whenever ids are handed out, so ids of deleted records are not
+// reused after a restart. All marks of one data directory share a single file.
+class IdAllocator {
+public:
+    explicit IdAllocator(const QString& entity);
+
+    // Reads the persisted mark for this entity; call before observing loaded records
+    void load(const QString& filePath);
+    // Raises the mark to at least id without persisting; the id is already stored with its record
+    void observe(int id);
+
+    int next();
+    // Allocates count consecutive ids and returns the first, for batch imports
+    int reserve(int count);
+
+    int highWaterMark() const { return last.load(); }
+
+private:
+    void persist(int mark) const;
+
+    QString entity;
+    QString filePath;
+    std::atomic<int> last{0};
+};
+
+#endif // IDALLOCATOR_H
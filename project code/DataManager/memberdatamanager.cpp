@@ -9,6 +9,10 @@
 #include <QCoreApplication>
 #include <QFileInfo>
 #include <QMutexLocker>
+#include "persistenceservice.h"
+#include "binarysnapshot.h"
+#include <algorithm>
+#include <limits>
 
 MemberDataManager::MemberDataManager(QObject* parent)
     : QObject(parent), userDataManager(nullptr) {
@@ -22,6 +26,7 @@ MemberDataManager::MemberDataManager(QObject* parent)
 #endif
 
     dataDir = projectDir + "/project code/Data";
+    memberIds.load(dataDir + "/id_allocators.json");
     QDir().mkpath(dataDir);
 
     QFile membersFile(dataDir + "/members.json");
@@ -39,11 +44,16 @@ MemberDataManager::MemberDataManager(QObject* parent)
         qDebug() << "Failed to load saved card data";
     }
 
-    QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &MemberDataManager::checkSubscriptionStatus);
-    timer->start(24 * 60 * 60 * 1000);
+    checkSubscriptionStatus();
 
-    setupRenewalTimer();
+    // Keep the data dirty if a background save of our files fails
+    connect(&PersistenceService::instance(), &PersistenceService::writeFinished, this,
+            [this](const QString& filePath, bool success) {
+                if (!success && (filePath == QDir(dataDir).filePath("members.json") ||
+                                 filePath == QDir(dataDir).filePath("saved_cards.json"))) {
+                    dataModified = true;
+                }
+            });
 }
 
 MemberDataManager::~MemberDataManager() {
@@ -60,6 +70,10 @@ void MemberDataManager::handleApplicationClosing() {
             qDebug() << "Failed to save card data before application closing!";
         }
     }
+
+    if (!PersistenceService::instance().flush()) {
+        qDebug() << "Some background saves failed before application closing!";
+    }
 }
 
 bool MemberDataManager::initializeFromFile() {
@@ -79,12 +93,20 @@ bool MemberDataManager::initializeFromFile() {
         int userId = memberObj["userId"].toInt();
 
         membersById[memberId] = member;
+        memberIds.observe(memberId);
 
         if (userId > 0) {
             userIdToMemberId[userId] = memberId;
         }
     }
 
+    subscriptionsByEndDate.clear();
+    indexedEndDates.clear();
+    membershipByUser.clear();
+    for (const auto& pair : membersById) {
+        indexSubscription(pair.first);
+    }
+
     return loadSavedCards();
 }
 
@@ -95,13 +117,14 @@ bool MemberDataManager::saveToFile() {
         return true;
     }
 
-    QJsonArray membersArray;
+    std::vector<Member> members;
+    members.reserve(membersById.size());
     for (const auto& pair : membersById) {
-        membersArray.append(memberToJson(pair.second));
+        members.push_back(pair.second);
     }
 
     QString errorMessage;
-    bool success = writeMembersToFile(membersArray, errorMessage);
+    bool success = writeMembersToFile(std::move(members), errorMessage);
     if (!success) {
         return false;
     }
@@ -120,7 +143,12 @@ bool MemberDataManager::addMember(const Member& member, QString& errorMessage) {
     int newId = generateMemberId();
     newMember.setId(newId);
     membersById[newId] = newMember;
+    if (newMember.getUserId() > 0) {
+        userIdToMemberId[newMember.getUserId()] = newId;
+    }
     dataModified = true;
+    indexSubscription(newId);
+    scheduleSubscriptionCheck();
     return true;
 }
 
@@ -146,6 +174,8 @@ bool MemberDataManager::updateMember(const Member& member, QString& errorMessage
 
     membersById[member.getId()] = member;
     dataModified = true;
+    indexSubscription(member.getId());
+    scheduleSubscriptionCheck();
 
     return true;
 }
@@ -157,8 +187,17 @@ bool MemberDataManager::deleteMember(int memberId, QString& errorMessage) {
         return false;
     }
 
+    const int userId = it->second.getUserId();
+    auto userIt = userIdToMemberId.find(userId);
+    if (userIt != userIdToMemberId.end() && userIt->second == memberId) {
+        userIdToMemberId.erase(userIt);
+    }
+
     membersById.erase(it);
     dataModified = true;
+    indexSubscription(memberId);
+    indexMembership(userId);
+    scheduleSubscriptionCheck();
     return true;
 }
 
@@ -186,6 +225,18 @@ QVector<Member> MemberDataManager::getAllMembers() const {
     return result;
 }
 
+QVector<int> MemberDataManager::getAllMemberIds() const {
+    QMutexLocker locker(&mutex);
+
+    QVector<int> result;
+    result.reserve(static_cast<int>(membersById.size()));
+    for (const auto& pair : membersById) {
+        result.append(pair.first);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 bool MemberDataManager::addSubscription(int memberId, const Subscription& subscription, QString& errorMessage) {
     auto it = membersById.find(memberId);
     if (it == membersById.end()) {
@@ -196,6 +247,8 @@ bool MemberDataManager::addSubscription(int memberId, const Subscription& subscr
     Member& member = it->second;
     member.setSubscription(subscription);
     dataModified = true;
+    indexSubscription(memberId);
+    scheduleSubscriptionCheck();
     return true;
 }
 
@@ -218,6 +271,8 @@ bool MemberDataManager::renewSubscription(int memberId, SubscriptionType newType
 
     member.setSubscription(newSubscription);
     dataModified = true;
+    indexSubscription(memberId);
+    scheduleSubscriptionCheck();
 
     emit vipStatusChanged(memberId, isVIP);
     return true;
@@ -234,6 +289,7 @@ bool MemberDataManager::cancelSubscription(int memberId, QString& errorMessage)
     Subscription& subscription = const_cast<Subscription&>(member.getSubscription());
     subscription.cancel();
     dataModified = true;
+    indexSubscription(memberId);
     return true;
 }
 
@@ -241,15 +297,8 @@ QVector<Member> MemberDataManager::getMembersNeedingRenewal(int daysThreshold) c
     QVector<Member> result;
     QDate currentDate = timeLogicInstance.getCurrentTime().date();
 
-    for (const auto& pair : membersById) {
-        const Member& member = pair.second;
-        const Subscription& subscription = member.getSubscription();
-        QDate endDate = subscription.getEndDate();
-        int daysLeft = currentDate.daysTo(endDate);
-
-        if (daysLeft <= daysThreshold && daysLeft >= 0) {
-            result.append(member);
-        }
+    for (int memberId : membersExpiringBetween(currentDate, currentDate.addDays(daysThreshold))) {
+        result.append(membersById.at(memberId));
     }
 
     return result;
@@ -312,50 +361,94 @@ QVector<QPair<int, QDate>> MemberDataManager::getRecentWorkouts(int memberId, in
 void MemberDataManager::checkSubscriptionStatus() {
     QDate currentDate = timeLogicInstance.getCurrentTime().date();
 
-    for (const auto& pair : membersById) {
-        int memberId = pair.first;
-        const Member& member = pair.second;
-        const Subscription& subscription = member.getSubscription();
-        QDate endDate = subscription.getEndDate();
-        int daysLeft = currentDate.daysTo(endDate);
+    // Everything that ended since the previous check (or ever, on the first one)
+    QDate expiredFrom = lastSubscriptionCheck.isValid() ? lastSubscriptionCheck.addDays(1) : QDate(1, 1, 1);
+    for (int memberId : membersExpiringBetween(expiredFrom, currentDate)) {
+        emit subscriptionExpired(memberId);
+    }
 
-        if (daysLeft <= 7 && daysLeft > 0) {
+    for (int memberId : membersExpiringBetween(currentDate.addDays(1),
+                                               currentDate.addDays(Subscription::EARLY_RENEWAL_THRESHOLD))) {
+        int daysLeft = currentDate.daysTo(indexedEndDates.at(memberId));
+        if (daysLeft <= 7) {
             emit subscriptionNearingExpiry(memberId, daysLeft);
-        } else if (daysLeft <= 0) {
-            emit subscriptionExpired(memberId);
+        }
+
+        if (isEligibleForEarlyRenewal(memberId)) {
+            RenewalOffer offer = getRenewalOffer(memberId);
+            emit earlyRenewalOfferAvailable(offer);
+
+            if (offer.daysUntilExpiry <= 3) {
+                emit renewalDiscountExpiring(memberId, offer.daysUntilExpiry);
+            }
         }
     }
+
+    lastSubscriptionCheck = currentDate;
+    scheduleSubscriptionCheck();
 }
 
-void MemberDataManager::setupRenewalTimer() {
-    renewalCheckTimer = new QTimer(this);
-    connect(renewalCheckTimer, &QTimer::timeout, this, [this]() {
+void MemberDataManager::scheduleSubscriptionCheck() {
+    SimulationScheduler& scheduler = SimulationScheduler::instance();
+    scheduler.cancel(subscriptionCheckEvent);
+    subscriptionCheckEvent = 0;
+
+    // Notices are due every day of the earliest renewal window and on expiry, nothing before
+    QDate tomorrow = timeLogicInstance.getCurrentTime().date().addDays(1);
+    auto next = subscriptionsByEndDate.lower_bound(std::make_pair(tomorrow, 0));
+    if (next == subscriptionsByEndDate.end()) {
+        return;
+    }
+
+    QDate dueDate = std::max(tomorrow, next->first.addDays(-Subscription::EARLY_RENEWAL_THRESHOLD));
+    subscriptionCheckEvent = scheduler.scheduleAt(QDateTime(dueDate, QTime(0, 0)), this, [this]() {
+        subscriptionCheckEvent = 0;
         checkSubscriptionStatus();
-        checkEarlyRenewalOffers();
     });
+}
 
-    renewalCheckTimer->start(12 * 60 * 60 * 1000);
+void MemberDataManager::indexSubscription(int memberId) {
+    auto indexedIt = indexedEndDates.find(memberId);
+    if (indexedIt != indexedEndDates.end()) {
+        subscriptionsByEndDate.erase(std::make_pair(indexedIt->second, memberId));
+        indexedEndDates.erase(indexedIt);
+    }
 
-    checkSubscriptionStatus();
-    checkEarlyRenewalOffers();
-}
+    auto it = membersById.find(memberId);
+    if (it == membersById.end()) {
+        return;
+    }
 
-void MemberDataManager::checkEarlyRenewalOffers() {
-    QDate currentDate = timeLogicInstance.getCurrentTime().date();
+    QDate endDate = it->second.getSubscription().getEndDate();
+    if (endDate.isValid()) {
+        subscriptionsByEndDate.emplace(endDate, memberId);
+        indexedEndDates[memberId] = endDate;
+    }
 
-    for (const auto& pair : membersById) {
-        int memberId = pair.first;
-        const Member& member = pair.second;
+    if (it->second.getUserId() > 0) {
+        indexMembership(it->second.getUserId());
+    }
+}
 
-        if (isEligibleForEarlyRenewal(memberId)) {
-            RenewalOffer offer = getRenewalOffer(memberId);
-            emit earlyRenewalOfferAvailable(offer);
+void MemberDataManager::indexMembership(int userId) {
+    auto userIt = userIdToMemberId.find(userId);
+    if (userIt == userIdToMemberId.end()) {
+        membershipByUser.remove(userId);
+        return;
+    }
 
-            if (offer.daysUntilExpiry <= 3) {
-                emit renewalDiscountExpiring(memberId, offer.daysUntilExpiry);
-            }
-        }
+    auto memberIt = membersById.find(userIt->second);
+    membershipByUser.insert(userId, memberIt != membersById.end() && memberIt->second.getSubscription().isVIP());
+}
+
+std::vector<int> MemberDataManager::membersExpiringBetween(const QDate& from, const QDate& to) const {
+    std::vector<int> result;
+    auto last = subscriptionsByEndDate.upper_bound(std::make_pair(to, std::numeric_limits<int>::max()));
+    for (auto it = subscriptionsByEndDate.lower_bound(std::make_pair(from, std::numeric_limits<int>::min()));
+         it != last; ++it) {
+        result.push_back(it->second);
     }
+    return result;
 }
 
 RenewalOffer MemberDataManager::getRenewalOffer(int memberId) const {
@@ -390,9 +483,10 @@ RenewalOffer MemberDataManager::getRenewalOffer(int memberId) const {
 
 QVector<RenewalOffer> MemberDataManager::getAllRenewalOffers() const {
     QVector<RenewalOffer> offers;
+    QDate currentDate = timeLogicInstance.getCurrentTime().date();
 
-    for (const auto& pair : membersById) {
-        int memberId = pair.first;
+    for (int memberId : membersExpiringBetween(currentDate.addDays(1),
+                                               currentDate.addDays(Subscription::EARLY_RENEWAL_THRESHOLD))) {
         if (isEligibleForEarlyRenewal(memberId)) {
             offers.append(getRenewalOffer(memberId));
         }
@@ -435,6 +529,11 @@ bool MemberDataManager::isEligibleForEarlyRenewal(int memberId) const {
 }
 
 QJsonArray MemberDataManager::readMembersFromFile(QString& errorMessage) const {
+    QJsonArray snapshotArray;
+    if (BinarySnapshot::readJsonArrayIfPreferred(QDir(dataDir).filePath("members.json"), snapshotArray)) {
+        return snapshotArray;
+    }
+
     QFile file(QDir(dataDir).filePath("members.json"));
     if (!file.exists()) {
         return QJsonArray();
@@ -463,10 +562,8 @@ QJsonArray MemberDataManager::readMembersFromFile(QString& errorMessage) const {
     return doc.array();
 }
 
-bool MemberDataManager::writeMembersToFile(const QJsonArray& members, QString& errorMessage) const {
-    QFile file(QDir(dataDir).filePath("members.json"));
-
-    QDir dir = QFileInfo(file).dir();
+bool MemberDataManager::writeMembersToFile(std::vector<Member> members, QString& errorMessage) const {
+    QDir dir(dataDir);
     if (!dir.exists()) {
         if (!dir.mkpath(".")) {
             errorMessage = "Failed to create data directory";
@@ -474,38 +571,17 @@ bool MemberDataManager::writeMembersToFile(const QJsonArray& members, QString& e
         }
     }
 
-    if (!file.open(QIODevice::WriteOnly)) {
-        errorMessage = "Could not open members file for writing: " + file.errorString();
-        return false;
-    }
-
-    QJsonDocument doc(members);
-    QByteArray jsonData = doc.toJson(QJsonDocument::Indented);
-
-    qint64 bytesWritten = file.write(jsonData);
-    if (bytesWritten == -1) {
-        errorMessage = "Failed to write to members file: " + file.errorString();
-        file.close();
-        return false;
-    }
-
-    if (bytesWritten != jsonData.size()) {
-        errorMessage = "Incomplete write to members file";
-        file.close();
-        return false;
-    }
-
-    if (!file.flush()) {
-        errorMessage = "Failed to flush file buffer: " + file.errorString();
-        file.close();
-        return false;
-    }
-
-    file.close();
+    BinarySnapshot::scheduleJsonArrayWrites(dir.filePath("members.json"), [members = std::move(members)]() {
+        QJsonArray membersArray;
+        for (const Member& member : members) {
+            membersArray.append(memberToJson(member));
+        }
+        return membersArray;
+    });
     return true;
 }
 
-QJsonObject MemberDataManager::memberToJson(const Member& member) const {
+QJsonObject MemberDataManager::memberToJson(const Member& member) {
     QJsonObject json;
 
     int memberId = member.getId();
@@ -582,14 +658,35 @@ Member MemberDataManager::jsonToMember(const QJsonObject& json) {
     return member;
 }
 
-int MemberDataManager::generateMemberId() const {
-    int maxId = 0;
-    for (const auto& pair : membersById) {
-        if (pair.first > maxId) {
-            maxId = pair.first;
+int MemberDataManager::generateMemberId() {
+    return memberIds.next();
+}
+
+int MemberDataManager::reserveMemberIds(int count) {
+    return memberIds.reserve(count);
+}
+
+void MemberDataManager::insertMembers(const std::vector<Member>& members) {
+    {
+        QMutexLocker locker(&mutex);
+
+        membersById.reserve(membersById.size() + members.size());
+        userIdToMemberId.reserve(userIdToMemberId.size() + members.size());
+
+        for (const Member& member : members) {
+            membersById[member.getId()] = member;
+            memberIds.observe(member.getId());
+            if (member.getUserId() > 0) {
+                userIdToMemberId[member.getUserId()] = member.getId();
+            }
+            indexSubscription(member.getId());
         }
+
+        dataModified = true;
+        scheduleSubscriptionCheck();
     }
-    return maxId + 1;
+
+    emit membersImported(static_cast<int>(members.size()));
 }
 
 bool MemberDataManager::saveCardData(int memberId, const QString& cardNumber, const QString& expiryDate,
@@ -696,12 +793,6 @@ bool MemberDataManager::loadSavedCards() {
 }
 
 bool MemberDataManager::saveSavedCards() const {
-    QFile file(QDir(dataDir).filePath("saved_cards.json"));
-
-    if (!file.open(QIODevice::WriteOnly)) {
-        return false;
-    }
-
     QJsonArray cardsArray;
 
     for (const auto& pair : savedCards) {
@@ -717,10 +808,8 @@ bool MemberDataManager::saveSavedCards() const {
         cardsArray.append(cardObj);
     }
 
-    QJsonDocument doc(cardsArray);
-    file.write(doc.toJson());
-    file.close();
-
+    PersistenceService::instance().scheduleWrite(QDir(dataDir).filePath("saved_cards.json"),
+                                                 QJsonDocument(cardsArray));
     return true;
 }
 
@@ -777,6 +866,8 @@ bool MemberDataManager::createMemberFromUser(const User& user, QString& errorMes
     userIdToMemberId[userId] = memberId;
 
     dataModified = true;
+    indexSubscription(memberId);
+    scheduleSubscriptionCheck();
 
     emit memberCreated(memberId, userId);
 
@@ -793,6 +884,32 @@ bool MemberDataManager::userIsMember(int userId) const {
     return (userIdToMemberId.find(userId) != userIdToMemberId.end());
 }
 
+QVector<int> MemberDataManager::findMemberIds(const QString& query) const {
+    QVector<int> result;
+    if (!userDataManager) {
+        return result;
+    }
+
+    // Name and email live with the user, so match users first and map them to members
+    const std::vector<int> userIds = userDataManager->findUserIds(query);
+
+    QMutexLocker locker(&mutex);
+    result.reserve(static_cast<int>(std::min(userIds.size(), userIdToMemberId.size())));
+    for (int userId : userIds) {
+        auto it = userIdToMemberId.find(userId);
+        if (it != userIdToMemberId.end()) {
+            result.append(it->second);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+QHash<int, bool> MemberDataManager::getMembershipSnapshot() const {
+    QMutexLocker locker(&mutex);
+    return membershipByUser;
+}
+
 int MemberDataManager::getMemberIdByUserId(int userId) const {
     QMutexLocker locker(&mutex);
 
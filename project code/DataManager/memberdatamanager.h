@@ -5,9 +5,14 @@
 #include "../Model/Gym/member.h"
 #include "../Model/Gym/subscription.h"
 #include "../DataManager/userdatamanager.h"
+#include "../DataManager/idallocator.h"
+#include "../Model/System/simulationScheduler.h"
+#include <QHash>
 #include <QString>
 #include <QVector>
 #include <unordered_map>
+#include <set>
+#include <vector>
 #include <QTimer>
 #include <QCryptographicHash>
 
@@ -45,12 +50,23 @@ public:
     bool deleteMember(int memberId, QString& errorMessage);
     Member getMemberById(int memberId) const;
     QVector<Member> getAllMembers() const;
+    QVector<int> getAllMemberIds() const;   // Ascending
+    // First of count consecutive member ids reserved for a batch import
+    int reserveMemberIds(int count);
+    // Adds members that already carry reserved ids under a single lock acquisition;
+    // emits membersImported once instead of memberCreated per member
+    void insertMembers(const std::vector<Member>& members);
 
     // User-to-Member conversion
     bool createMemberFromUser(int userId, QString& errorMessage);
     bool createMemberFromUser(const User& user, QString& errorMessage);
     bool userIsMember(int userId) const;
     int getMemberIdByUserId(int userId) const;
+    // Ids of members whose user's name or email contains query, case-insensitively
+    QVector<int> findMemberIds(const QString& query) const;
+    // userId -> whether that user's member holds a VIP subscription, for every member.
+    // Implicitly shared, so this is O(1) and the copy stays as it is while members change.
+    QHash<int, bool> getMembershipSnapshot() const;
     Member getMemberByUserId(int userId) const;
 
     // Subscription management
@@ -94,26 +110,39 @@ signals:
     void earlyRenewalOfferAvailable(const RenewalOffer& offer);
     void renewalDiscountExpiring(int memberId, int daysLeft);
     void memberCreated(int memberId, int userId);
+    void membersImported(int count);
     void memberUpdated(int memberId);
 
 private:
     QString dataDir;
     mutable QMutex mutex;
     std::unordered_map<int, Member> membersById;
+    IdAllocator memberIds{"members"};
     std::unordered_map<int, int> userIdToMemberId; // Maps user IDs to member IDs
     std::unordered_map<int, SavedCardData> savedCards;
     bool dataModified = false;
-    QTimer* renewalCheckTimer;
+    // Members ordered by subscription end date, so expiry questions are range queries
+    std::set<std::pair<QDate, int>> subscriptionsByEndDate;
+    std::unordered_map<int, QDate> indexedEndDates;
+    // Kept up to date with userIdToMemberId and the subscriptions, see getMembershipSnapshot()
+    QHash<int, bool> membershipByUser;
+    QDate lastSubscriptionCheck;
+    SimulationScheduler::EventId subscriptionCheckEvent = 0;
     UserDataManager* userDataManager;
 
     QJsonArray readMembersFromFile(QString& errorMessage) const;
-    bool writeMembersToFile(const QJsonArray& members, QString& errorMessage) const;
-    QJsonObject memberToJson(const Member& member) const;
+    // The JSON is built from these copies on the persistence thread
+    bool writeMembersToFile(std::vector<Member> members, QString& errorMessage) const;
+    static QJsonObject memberToJson(const Member& member);
     static Member jsonToMember(const QJsonObject& json);
-    [[nodiscard]] int generateMemberId() const;
+    int generateMemberId();
     void checkSubscriptionStatus();
-    void checkEarlyRenewalOffers();
-    void setupRenewalTimer();
+    void scheduleSubscriptionCheck();
+    // Also refreshes membershipByUser for the member's user
+    void indexSubscription(int memberId);
+    void indexMembership(int userId);
+    // Members whose subscription ends in [from, to]
+    std::vector<int> membersExpiringBetween(const QDate& from, const QDate& to) const;
     
     // Private card data methods
     bool loadSavedCards();
@@ -0,0 +1,294 @@
+#include "memberimporter.h"
+#include "userdatamanager.h"
+#include "memberdatamanager.h"
+#include "passwordhasher.h"
+#include "persistenceservice.h"
+#include "../Model/System/timeLogic.h"
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+// Splits CSV text into records of fields; quoted fields may hold commas, quotes ("") and
+// line breaks. lineNumbers receives the line each record starts on.
+QVector<QStringList> parseCsv(const QString& text, QVector<int>& lineNumbers) {
+    QVector<QStringList> records;
+    QStringList fields;
+    QString field;
+    bool quoted = false;
+    bool recordStarted = false;
+    int line = 1;
+    int recordLine = 1;
+
+    auto endRecord = [&]() {
+        if (recordStarted) {
+            fields.append(field);
+            records.append(fields);
+            lineNumbers.append(recordLine);
+        }
+        fields.clear();
+        field.clear();
+        recordStarted = false;
+    };
+
+    for (int i = 0; i < text.size(); ++i) {
+        const QChar c = text.at(i);
+        if (!recordStarted) {
+            recordLine = line;
+        }
+
+        if (quoted) {
+            if (c == '"' && i + 1 < text.size() && text.at(i + 1) == '"') {
+                field.append('"');
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                if (c == '\n') {
+                    ++line;
+                }
+                field.append(c);
+            }
+            continue;
+        }
+
+        if (c == '"') {
+            quoted = true;
+            recordStarted = true;
+        } else if (c == ',') {
+            fields.append(field);
+            field.clear();
+            recordStarted = true;
+        } else if (c == '\n') {
+            endRecord();
+            ++line;
+        } else if (c != '\r') {
+            field.append(c);
+            recordStarted = true;
+        }
+    }
+    endRecord();
+
+    return records;
+}
+
+bool parseBool(const QString& value) {
+    const QString folded = value.trimmed().toLower();
+    return folded == "true" || folded == "1" || folded == "yes";
+}
+
+} // namespace
+
+bool MemberImporter::readFile(const QString& filePath, std::vector<Row>& rows, QString& errorMessage) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = "Failed to open import file: " + file.errorString();
+        return false;
+    }
+
+    const QByteArray data = file.readAll();
+    return filePath.endsWith(".json", Qt::CaseInsensitive)
+        ? readJson(data, rows, errorMessage)
+        : readCsv(data, rows, errorMessage);
+}
+
+bool MemberImporter::readCsv(const QByteArray& data, std::vector<Row>& rows, QString& errorMessage) {
+    QVector<int> lineNumbers;
+    const QVector<QStringList> records = parseCsv(QString::fromUtf8(data), lineNumbers);
+    if (records.isEmpty()) {
+        errorMessage = "Import file is empty";
+        return false;
+    }
+
+    QHash<QString, int> columns;
+    for (int i = 0; i < records.first().size(); ++i) {
+        columns.insert(records.first().at(i).trimmed().toLower(), i);
+    }
+
+    for (const char* required : {"name", "email", "password", "dateofbirth"}) {
+        if (!columns.contains(required)) {
+            errorMessage = QString("Missing column in CSV header: %1").arg(required);
+            return false;
+        }
+    }
+
+    rows.reserve(rows.size() + records.size() - 1);
+    for (int i = 1; i < records.size(); ++i) {
+        const QStringList& fields = records.at(i);
+        auto value = [&](const char* column) {
+            const int index = columns.value(column, -1);
+            return index >= 0 ? fields.value(index).trimmed() : QString();
+        };
+
+        Row row;
+        row.source = lineNumbers.at(i);
+        if (fields.size() != records.first().size()) {
+            row.error = QString("Expected %1 fields, found %2").arg(records.first().size()).arg(fields.size());
+        }
+        row.name = value("name");
+        row.email = value("email");
+        row.password = value("password");
+        row.dateOfBirth = QDate::fromString(value("dateofbirth"), Qt::ISODate);
+        row.subscription = value("subscription");
+        row.subscriptionStart = QDate::fromString(value("subscriptionstart"), Qt::ISODate);
+        row.vip = parseBool(value("vip"));
+        rows.push_back(std::move(row));
+    }
+
+    return true;
+}
+
+bool MemberImporter::readJson(const QByteArray& data, std::vector<Row>& rows, QString& errorMessage) {
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(data, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        errorMessage = "JSON parse error: " + parseError.errorString();
+        return false;
+    }
+    if (!document.isArray()) {
+        errorMessage = "Import file must contain a JSON array of members";
+        return false;
+    }
+
+    const QJsonArray entries = document.array();
+    rows.reserve(rows.size() + entries.size());
+    for (int i = 0; i < entries.size(); ++i) {
+        Row row;
+        row.source = i + 1;
+        if (!entries.at(i).isObject()) {
+            row.error = "Entry is not an object";
+            rows.push_back(std::move(row));
+            continue;
+        }
+
+        const QJsonObject json = entries.at(i).toObject();
+        row.name = json["name"].toString().trimmed();
+        row.email = json["email"].toString().trimmed();
+        row.password = json["password"].toString();
+        row.dateOfBirth = QDate::fromString(json["dateOfBirth"].toString(), Qt::ISODate);
+        row.subscription = json["subscription"].toString().trimmed();
+        row.subscriptionStart = QDate::fromString(json["subscriptionStart"].toString(), Qt::ISODate);
+        row.vip = json["vip"].isString() ? parseBool(json["vip"].toString()) : json["vip"].toBool(false);
+        rows.push_back(std::move(row));
+    }
+
+    return true;
+}
+
+void MemberImporter::validate(Row& row, const QDate& today) {
+    if (!row.error.isEmpty()) {
+        return;
+    }
+
+    QString errorMessage;
+    if (!UserDataManager::validateName(row.name, errorMessage)) {
+        row.error = "Name: " + errorMessage;
+        return;
+    }
+    if (!UserDataManager::validateEmail(row.email, errorMessage)) {
+        row.error = "Email: " + errorMessage;
+        return;
+    }
+    if (!UserDataManager::validateDateOfBirth(row.dateOfBirth, errorMessage)) {
+        row.error = "Date of birth: " + errorMessage;
+        return;
+    }
+
+    if (!row.subscription.isEmpty()) {
+        const SubscriptionType type = Subscription::stringToType(row.subscription);
+        if (Subscription::typeToString(type) != row.subscription) {
+            row.error = "Unknown subscription type: " + row.subscription;
+            return;
+        }
+        if (!row.subscriptionStart.isValid()) {
+            row.subscriptionStart = today;
+        }
+    }
+
+    // Hashing dominates the cost of a row, so it happens here on the worker as well
+    if (!PasswordHasher::isHash(row.password)) {
+        if (!UserDataManager::validatePassword(row.password, errorMessage)) {
+            row.error = "Password: " + errorMessage;
+            return;
+        }
+        row.password = PasswordHasher::hash(row.password);
+    }
+}
+
+MemberImporter::Report MemberImporter::import(std::vector<Row>& rows, UserDataManager& userManager,
+                                              MemberDataManager& memberManager) {
+    Report report;
+
+    // Duplicates first, so rows that cannot be imported are never hashed
+    QSet<QString> seenEmails;
+    seenEmails.reserve(static_cast<qsizetype>(rows.size()));
+    for (Row& row : rows) {
+        if (!row.error.isEmpty() || row.email.isEmpty()) {
+            continue;
+        }
+        if (userManager.emailExists(row.email)) {
+            row.error = "Email is already registered";
+        } else if (seenEmails.contains(row.email)) {
+            row.error = "Duplicate email in import file";
+        } else {
+            seenEmails.insert(row.email);
+        }
+    }
+
+    const QDate today = timeLogicInstance.getCurrentTime().date();
+    QtConcurrent::blockingMap(rows, [today](Row& row) { validate(row, today); });
+
+    const int accepted = static_cast<int>(std::count_if(rows.begin(), rows.end(),
+                                                        [](const Row& row) { return row.error.isEmpty(); }));
+
+    if (accepted > 0) {
+        int nextUserId = userManager.reserveUserIds(accepted);
+        int nextMemberId = memberManager.reserveMemberIds(accepted);
+
+        std::vector<User> users;
+        std::vector<Member> members;
+        users.reserve(accepted);
+        members.reserve(accepted);
+
+        for (const Row& row : rows) {
+            if (!row.error.isEmpty()) {
+                continue;
+            }
+
+            User user(row.name, row.email, row.password, QString(), row.dateOfBirth);
+            user.setId(nextUserId++);
+
+            Member member(nextMemberId++, user.getId());
+            if (!row.subscription.isEmpty()) {
+                Subscription subscription(Subscription::stringToType(row.subscription), row.subscriptionStart);
+                subscription.setVIP(row.vip);
+                member.setSubscription(subscription);
+            }
+
+            users.push_back(std::move(user));
+            members.push_back(std::move(member));
+        }
+
+        userManager.insertUsers(users);
+        memberManager.insertMembers(members);
+
+        const bool scheduled = userManager.saveToFile() && memberManager.saveToFile();
+        if (!PersistenceService::instance().flush() || !scheduled) {
+            report.saveError = "Imported users or members could not be written to disk";
+        }
+    }
+
+    report.imported = accepted;
+    for (const Row& row : rows) {
+        if (!row.error.isEmpty()) {
+            report.errors.append({row.source, row.error});
+        }
+    }
+    return report;
+}
@@ -0,0 +1,60 @@
+#ifndef MEMBERIMPORTER_H
+#define MEMBERIMPORTER_H
+
+#include <QDate>
+#include <QString>
+#include <QVector>
+#include <vector>
+
+class UserDataManager;
+class MemberDataManager;
+
+// Batch creation of users and their members, e.g. when onboarding a partner gym.
+//
+// Rows come from CSV with a header line naming the columns
+//   name,email,password,dateOfBirth[,subscription,subscriptionStart,vip]
+// or from a JSON array of objects with the same keys. Dates are ISO 8601, subscription
+// is a Subscription::typeToString name, and an empty subscription creates a member
+// without one. The password may be plain text or an already encoded password hash.
+//
+// Rows are validated and their passwords hashed in parallel; user and member ids are
+// then reserved as one block each and every row is inserted in a single pass, followed
+// by one save and persistence flush. Rows that fail are reported and skipped.
+class MemberImporter {
+public:
+    struct Row {
+        int source = 0;              // CSV line or JSON entry number, 1-based
+        QString name;
+        QString email;
+        QString password;
+        QDate dateOfBirth;
+        QString subscription;
+        QDate subscriptionStart;     // Defaults to the current simulated date
+        bool vip = false;
+        QString error;               // Set by parsing or validation
+    };
+
+    struct RowError {
+        int source;
+        QString message;
+    };
+
+    struct Report {
+        int imported = 0;            // Rows inserted; on disk only if saveError is empty
+        QVector<RowError> errors;    // Ordered by source
+        QString saveError;           // Set when the imported data could not be written
+    };
+
+    // Chooses the format by extension: .json, anything else is read as CSV
+    static bool readFile(const QString& filePath, std::vector<Row>& rows, QString& errorMessage);
+
+    static Report import(std::vector<Row>& rows, UserDataManager& userManager, MemberDataManager& memberManager);
+
+private:
+    static bool readCsv(const QByteArray& data, std::vector<Row>& rows, QString& errorMessage);
+    static bool readJson(const QByteArray& data, std::vector<Row>& rows, QString& errorMessage);
+    // Runs on worker threads: touches nothing but the row
+    static void validate(Row& row, const QDate& today);
+};
+
+#endif // MEMBERIMPORTER_H
@@ -12,6 +12,11 @@
 #include <algorithm>
 #include <QDateTime>
 #include <QMetaObject>
+#include <utility>
+#include "persistenceservice.h"
+#include "binarysnapshot.h"
+#include <QtEndian>
+#include <cstring>
 
 PadelDataManager::PadelDataManager(QObject* parent)
     : QObject(parent), memberDataManager(nullptr) {
@@ -26,6 +31,8 @@ PadelDataManager::PadelDataManager(QObject* parent)
 #endif
 
     dataDir = projectDir + "/project code/Data";
+    courtIds.load(dataDir + "/id_allocators.json");
+    bookingIds.load(dataDir + "/id_allocators.json");
 
     QDir().mkpath(dataDir);
 
@@ -53,9 +60,26 @@ PadelDataManager::PadelDataManager(QObject* parent)
         }
     }
 
+    journalFile.setFileName(dataDir + "/padel_journal.jsonl");
+    compactingJournalPath = dataDir + "/padel_journal.compacting.jsonl";
+
     initializeFromFile();
 
-    setupTimers();
+    scheduleStatusCheck(timeLogicInstance.getCurrentTime());
+
+    PersistenceService& persistence = PersistenceService::instance();
+    connect(&persistence, &PersistenceService::writeFinished, this,
+            [this](const QString& filePath, bool success) {
+                if (success) {
+                    return;
+                }
+                const QString fileName = QFileInfo(filePath).fileName();
+                if (fileName == "bookings.json" || fileName == "courts.json" || fileName == "waitlists.json") {
+                    snapshotWriteFailed = true;
+                    dataModified = true;
+                }
+            });
+    connect(&persistence, &PersistenceService::barrierReached, this, &PadelDataManager::onPersistenceBarrier);
 }
 
 PadelDataManager::~PadelDataManager() {
@@ -66,11 +90,30 @@ void PadelDataManager::handleApplicationClosing() {
     if (dataModified) {
         saveToFile();
     }
+
+    if (PersistenceService::instance().flush() && !snapshotWriteFailed) {
+        QFile::remove(compactingJournalPath);
+    }
+
+    QMutexLocker journalLocker(&journalMutex);
+    journalFile.close();
+}
+
+void PadelDataManager::onPersistenceBarrier(quint64 ticket) {
+    if (ticket != compactionTicket) {
+        return;
+    }
+
+    // The latest snapshot is durable, so the parked journal entries are no longer needed
+    if (!snapshotWriteFailed) {
+        QFile::remove(compactingJournalPath);
+    }
+    snapshotWriteFailed = false;
 }
 
 bool PadelDataManager::initializeFromFile() {
     QString errorMessage;
-    QMutexLocker locker(&mutex);
+    QWriteLocker locker(&courtsLock);
 
     QJsonArray courtsArray = readCourtsFromFile(errorMessage);
     if (!errorMessage.isEmpty()) {
@@ -78,22 +121,26 @@ bool PadelDataManager::initializeFromFile() {
     }
 
     courtsById.clear();
+    shards.clear();
     for (const QJsonValue& courtValue : courtsArray) {
         QJsonObject courtObj = courtValue.toObject();
         Court court = jsonToCourt(courtObj);
         courtsById[court.getId()] = court;
+        courtIds.observe(court.getId());
+        ensureShard(court.getId());
     }
 
-    QJsonArray bookingsArray = readBookingsFromFile(errorMessage);
-    if (!errorMessage.isEmpty()) {
-        return false;
-    }
+    clearLoadedBookings();
+    if (!readBookingsSnapshot(errorMessage)) {
+        QJsonArray bookingsArray = readBookingsFromFile(errorMessage);
+        if (!errorMessage.isEmpty()) {
+            return false;
+        }
 
-    bookingsById.clear();
-    for (const QJsonValue& bookingValue : bookingsArray) {
-        QJsonObject bookingObj = bookingValue.toObject();
-        Booking booking = jsonToBooking(bookingObj);
-        bookingsById[booking.getBookingId()] = booking;
+        for (const QJsonValue& bookingValue : bookingsArray) {
+            QJsonObject bookingObj = bookingValue.toObject();
+            storeLoadedBooking(jsonToBooking(bookingObj));
+        }
     }
 
     QJsonArray waitlistsArray = readWaitlistsFromFile(errorMessage);
@@ -101,24 +148,17 @@ bool PadelDataManager::initializeFromFile() {
         return false;
     }
 
-    courtWaitlists.clear();
     for (const QJsonValue& entryValue : waitlistsArray) {
-        QJsonObject entryObj = entryValue.toObject();
-
-        WaitlistEntry entry;
-        if (entryObj.contains("userId")) {
-            entry.memberId = entryObj["userId"].toInt();
-        } else {
-            entry.memberId = entryObj["memberId"].toInt();
-        }
+        WaitlistEntry entry = jsonToWaitlistEntry(entryValue.toObject());
+        ensureShard(entry.courtId).waitlist.push(entry);
+    }
 
-        entry.courtId = entryObj["courtId"].toInt();
-        entry.requestedTime = QDateTime::fromString(entryObj["requestedTime"].toString(), Qt::ISODate);
-        entry.isVIP = entryObj["isVIP"].toBool();
-        entry.priority = entryObj["priority"].toInt();
+    if (!replayJournal(errorMessage)) {
+        return false;
+    }
 
-        int courtId = entry.courtId;
-        courtWaitlists[courtId].push(entry);
+    for (auto& pair : shards) {
+        rebuildBookingIndex(*pair.second);
     }
 
     return true;
@@ -139,129 +179,83 @@ bool PadelDataManager::saveToFile() {
         }
     }
 
-    QJsonArray waitlistsArray = waitlistsToJson();
-    QString waitlistsPath = QDir(dataDir).filePath("waitlists.json");
-    QFile waitlistsFile(waitlistsPath);
+    std::vector<WaitlistEntry> waitlists;
+    auto bookings = std::make_shared<std::vector<Booking>>();
+    std::vector<Court> courts;
 
-    if (!waitlistsFile.open(QIODevice::WriteOnly)) {
-        return false;
-    }
-
-    QJsonDocument waitlistsDoc(waitlistsArray);
-    QByteArray waitlistsData = waitlistsDoc.toJson(QJsonDocument::Indented);
+    {
+        // Hold every shard so the snapshot and the journal rotation see the same state
+        QReadLocker courtsLocker(&courtsLock);
+        for (auto& pair : shards) {
+            pair.second->lock.lockForRead();
+        }
 
-    qint64 waitlistsBytesWritten = waitlistsFile.write(waitlistsData);
-    if (waitlistsBytesWritten == -1) {
-        waitlistsFile.close();
-        return false;
-    }
+        // Only plain copies are taken here, so writers are held up for a copy, not for JSON
+        courts.reserve(courtsById.size());
+        for (const auto& pair : courtsById) {
+            courts.push_back(pair.second);
+        }
 
-    waitlistsFile.flush();
-    waitlistsFile.close();
-    QJsonArray bookingsArray;
-    for (const auto& pair : bookingsById) {
-        bookingsArray.append(bookingToJson(pair.second));
-    }
-    
-    QString bookingsPath = QDir(dataDir).filePath("bookings.json");
-    QFile bookingsFile(bookingsPath);
-    
-    if (!bookingsFile.open(QIODevice::WriteOnly)) {
-        return false;
-    }
-    
-    QJsonDocument bookingsDoc(bookingsArray);
-    QByteArray bookingsData = bookingsDoc.toJson(QJsonDocument::Indented);
-    
-    qint64 bookingsBytesWritten = bookingsFile.write(bookingsData);
-    if (bookingsBytesWritten == -1) {
-        bookingsFile.close();
-        return false;
-    }
-    
-    bookingsFile.flush();
-    bookingsFile.close();
-    QJsonArray courtsArray;
-    for (const auto& pair : courtsById) {
-        courtsArray.append(courtToJson(pair.second));
-    }
-    
-    QString courtsPath = QDir(dataDir).filePath("courts.json");
-    QFile courtsFile(courtsPath);
-    
-    if (!courtsFile.open(QIODevice::WriteOnly)) {
-        return false;
-    }
-    
-    QJsonDocument courtsDoc(courtsArray);
-    QByteArray courtsData = courtsDoc.toJson(QJsonDocument::Indented);
-    
-    qint64 courtsBytesWritten = courtsFile.write(courtsData);
-    if (courtsBytesWritten == -1) {
-        courtsFile.close();
-        return false;
-    }
-    
-    courtsFile.flush();
-    courtsFile.close();
-    
-    dataModified = false;
-    return true;
-}
+        for (const auto& pair : shards) {
+            const CourtShard& shard = *pair.second;
+            for (const auto& bookingPair : shard.bookings) {
+                bookings->push_back(bookingPair.second);
+            }
+            for (WaitlistEntry entry : shard.waitlist) {
+                entry.courtId = pair.first;
+                waitlists.push_back(entry);
+            }
+        }
 
-bool PadelDataManager::writeBookingsToFile(const QJsonArray& bookings, QString& errorMessage) const {
-    QString filePath = QDir(dataDir).filePath("bookings.json");
-    QFile file(filePath);
-    QFileInfo fileInfo(filePath);
-    QDir().mkpath(fileInfo.absolutePath());
+        // Entries journaled so far are covered by this snapshot; park them until it is on disk
+        rotateJournal();
+        dataModified = false;
 
-    if (!file.open(QIODevice::WriteOnly)) {
-        errorMessage = "Could not open bookings file for writing: " + file.errorString();
-        return false;
+        for (auto& pair : shards) {
+            pair.second->lock.unlock();
+        }
     }
 
-    QJsonDocument doc(bookings);
-    QByteArray jsonData = doc.toJson(QJsonDocument::Indented);
-
-    qint64 bytesWritten = file.write(jsonData);
-    if (bytesWritten == -1) {
-        errorMessage = "Failed to write to bookings file: " + file.errorString();
-        file.close();
+    if (!writeWaitlistsToFile(std::move(waitlists), errorMessage) ||
+        !writeBookingsToFile(bookings, errorMessage) ||
+        !writeCourtsToFile(std::move(courts), errorMessage)) {
+        dataModified = true;
         return false;
     }
+    writeBookingsSnapshot(std::move(bookings));
 
-    file.flush();
-    file.close();
+    compactionTicket = PersistenceService::instance().scheduleBarrier();
     return true;
 }
 
-bool PadelDataManager::writeCourtsToFile(const QJsonArray& courts, QString& errorMessage) const {
-    QString filePath = QDir(dataDir).filePath("courts.json");
-    QFile file(filePath);
-    QFileInfo fileInfo(filePath);
-    QDir().mkpath(fileInfo.absolutePath());
-
-    if (!file.open(QIODevice::WriteOnly)) {
-        errorMessage = "Could not open courts file for writing: " + file.errorString();
-        return false;
-    }
-
-    QJsonDocument doc(courts);
-    QByteArray jsonData = doc.toJson(QJsonDocument::Indented);
-
-    qint64 bytesWritten = file.write(jsonData);
-    if (bytesWritten == -1) {
-        errorMessage = "Failed to write to courts file: " + file.errorString();
-        file.close();
-        return false;
-    }
+bool PadelDataManager::writeBookingsToFile(std::shared_ptr<const std::vector<Booking>> bookings,
+                                           QString& errorMessage) const {
+    Q_UNUSED(errorMessage);
+    // bookings.bin has its own typed schema (writeBookingsSnapshot)
+    BinarySnapshot::scheduleJsonArrayWrites(QDir(dataDir).filePath("bookings.json"), [bookings]() {
+        QJsonArray bookingsArray;
+        for (const Booking& booking : *bookings) {
+            bookingsArray.append(bookingToJson(booking));
+        }
+        return bookingsArray;
+    }, QString(), false);
+    return true;
+}
 
-    file.flush();
-    file.close();
+bool PadelDataManager::writeCourtsToFile(std::vector<Court> courts, QString& errorMessage) const {
+    Q_UNUSED(errorMessage);
+    BinarySnapshot::scheduleJsonArrayWrites(QDir(dataDir).filePath("courts.json"),
+                                            [courts = std::move(courts)]() {
+        QJsonArray courtsArray;
+        for (const Court& court : courts) {
+            courtsArray.append(courtToJson(court));
+        }
+        return courtsArray;
+    });
     return true;
 }
 
-QJsonObject PadelDataManager::courtToJson(const Court& court) const {
+QJsonObject PadelDataManager::courtToJson(const Court& court) {
     QJsonObject json;
     json["id"] = court.getId();
     json["name"] = court.getName();
@@ -293,7 +287,7 @@ QJsonObject PadelDataManager::courtToJson(const Court& court) const {
     return json;
 }
 
-QJsonObject PadelDataManager::bookingToJson(const Booking& booking) const {
+QJsonObject PadelDataManager::bookingToJson(const Booking& booking) {
     QJsonObject json;
     json["id"] = booking.getBookingId();
     json["courtId"] = booking.getCourtId();
@@ -327,62 +321,72 @@ Booking PadelDataManager::jsonToBooking(const QJsonObject& json) {
 }
 
 bool PadelDataManager::addCourt(const Court& court, QString& errorMessage) {
-    QMutexLocker locker(&mutex);
-
     if (court.getId() != 0) {
         errorMessage = "Court already has an ID";
         return false;
     }
 
-    Court newCourt = court;
-    int newId = generateCourtId();
-    newCourt.setId(newId);
-    courtsById[newId] = newCourt;
-    dataModified = true;
+    int newId;
+    {
+        QWriteLocker locker(&courtsLock);
+
+        Court newCourt = court;
+        newId = generateCourtId();
+        newCourt.setId(newId);
+        courtsById[newId] = newCourt;
+        ensureShard(newId);
+        dataModified = true;
+    }
 
     emit courtAdded(newId);
     return true;
 }
 
 bool PadelDataManager::updateCourt(const Court& court, QString& errorMessage) {
-    QMutexLocker locker(&mutex);
-
     if (court.getId() <= 0) {
         errorMessage = "Invalid court ID";
         return false;
     }
 
-    auto it = courtsById.find(court.getId());
-    if (it == courtsById.end()) {
-        errorMessage = "Court not found";
-        return false;
-    }
+    {
+        QWriteLocker locker(&courtsLock);
 
-    courtsById[court.getId()] = court;
-    dataModified = true;
+        auto it = courtsById.find(court.getId());
+        if (it == courtsById.end()) {
+            errorMessage = "Court not found";
+            return false;
+        }
+
+        it->second = court;
+        dataModified = true;
+    }
 
     emit courtUpdated(court.getId());
     return true;
 }
 
 bool PadelDataManager::deleteCourt(int courtId, QString& errorMessage) {
-    QMutexLocker locker(&mutex);
-
-    auto it = courtsById.find(courtId);
-    if (it == courtsById.end()) {
-        errorMessage = "Court not found";
-        return false;
-    }
+    {
+        QWriteLocker locker(&courtsLock);
 
-    for (const auto& pair : bookingsById) {
-        if (pair.second.getCourt().getId() == courtId) {
-            errorMessage = "Cannot delete court with existing bookings";
+        auto it = courtsById.find(courtId);
+        if (it == courtsById.end()) {
+            errorMessage = "Court not found";
             return false;
         }
-    }
 
-    courtsById.erase(it);
-    dataModified = true;
+        auto shardIt = shards.find(courtId);
+        if (shardIt != shards.end()) {
+            QReadLocker shardLocker(&shardIt->second->lock);
+            if (!shardIt->second->bookings.empty()) {
+                errorMessage = "Cannot delete court with existing bookings";
+                return false;
+            }
+        }
+
+        courtsById.erase(it);
+        dataModified = true;
+    }
 
     emit courtDeleted(courtId);
     return true;
@@ -393,12 +397,7 @@ Court PadelDataManager::getCourtById(int courtId) const {
         return Court();
     }
 
-    QMutex& mutexRef = mutex;
-    QMutexLocker locker(&mutexRef);
-
-    if (courtsById.empty()) {
-        return Court();
-    }
+    QReadLocker locker(&courtsLock);
 
     auto it = courtsById.find(courtId);
     if (it != courtsById.end()) {
@@ -409,7 +408,7 @@ Court PadelDataManager::getCourtById(int courtId) const {
 }
 
 QVector<Court> PadelDataManager::getAllCourts() const {
-    QMutexLocker locker(&mutex);
+    QReadLocker locker(&courtsLock);
 
     QVector<Court> result;
     result.reserve(courtsById.size());
@@ -420,7 +419,7 @@ QVector<Court> PadelDataManager::getAllCourts() const {
 }
 
 QVector<Court> PadelDataManager::getCourtsByLocation(const QString& location) const {
-    QMutexLocker locker(&mutex);
+    QReadLocker locker(&courtsLock);
 
     QVector<Court> result;
     for (const auto& pair : courtsById) {
@@ -443,17 +442,18 @@ bool PadelDataManager::createBooking(int userId, int courtId, const QDateTime& s
         return false;
     }
 
-    QMutexLocker locker(&mutex);
+    int maxAttendees;
+    {
+        QReadLocker courtsLocker(&courtsLock);
 
-    auto courtIt = courtsById.find(courtId);
-    if (courtIt == courtsById.end()) {
-        errorMessage = "Court not found with ID: " + QString::number(courtId);
-        return false;
+        auto courtIt = courtsById.find(courtId);
+        if (courtIt == courtsById.end()) {
+            errorMessage = "Court not found with ID: " + QString::number(courtId);
+            return false;
+        }
+        maxAttendees = courtIt->second.getMaxAttendees();
     }
 
-    const Court& court = courtIt->second;
-    int maxAttendees = court.getMaxAttendees();
-
     if (!startTime.isValid() || !endTime.isValid()) {
         errorMessage = "Invalid booking time";
         return false;
@@ -464,68 +464,53 @@ bool PadelDataManager::createBooking(int userId, int courtId, const QDateTime& s
         return false;
     }
 
-    int currentAttendees = 0;
-
-    for (const auto& pair : bookingsById) {
-        const Booking& existingBooking = pair.second;
+    // Look up everything owned by other managers before taking the court's lock
+    const WaitlistEntry waitlistEntry = makeWaitlistEntry(userId, courtId, startTime);
+    UserDataManager* userManager = memberDataManager ? memberDataManager->getUserDataManager() : nullptr;
+    const User user = userManager ? userManager->getUserDataById(userId) : User();
+    const bool isVip = waitlistEntry.isVIP;
+    const double price = calculateBookingPrice(courtId, startTime, endTime, isVip);
 
-        if (existingBooking.isCancelled()) {
-            continue;
-        }
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
+        errorMessage = "Court not found with ID: " + QString::number(courtId);
+        return false;
+    }
 
-        if (existingBooking.getCourtId() != courtId) {
-            continue;
-        }
+    QWriteLocker locker(&shard->lock);
 
-        if (!existingBooking.getStartTime().isValid() ||
-            !startTime.isValid() ||
-            existingBooking.getStartTime().date() != startTime.date()) {
-            continue;
-        }
+    int currentAttendees = 0;
+    const std::multimap<qint32, int>* dayBookings = bookingsOnDay(*shard, startTime.date());
 
-        if (!existingBooking.getStartTime().isValid() ||
-            !existingBooking.getEndTime().isValid()) {
-            continue;
-        }
+    if (dayBookings) {
+        const qint32 start = Booking::toEpochMinutes(startTime);
+        auto last = dayBookings->upper_bound(Booking::toEpochMinutes(endTime));
+        for (auto entryIt = dayBookings->begin(); entryIt != last; ++entryIt) {
+            const Booking& existingBooking = shard->bookings.at(entryIt->second);
 
-        bool overlap = (existingBooking.getStartTime() <= endTime &&
-                       existingBooking.getEndTime() >= startTime);
+            if (existingBooking.getEndMinutes() == Booking::InvalidTime) {
+                continue;
+            }
 
-        if (overlap) {
-            currentAttendees++;
+            if (existingBooking.getEndMinutes() >= start) {
+                currentAttendees++;
+            }
         }
     }
 
     if (currentAttendees >= maxAttendees) {
-        bool isVip = false;
-
-        if (memberDataManager) {
-            if (memberDataManager->userIsMember(userId)) {
-                int memberId = memberDataManager->getMemberIdByUserId(userId);
-                isVip = memberDataManager->isVIPMember(memberId);
-            }
-        }
-
-        QString waitlistError;
-        if (addToWaitlist(userId, courtId, startTime, waitlistError)) {
-            errorMessage = "Court is at maximum capacity. You have been added to the waitlist.";
-            return false;
-        } else {
-            errorMessage = "Court is at maximum capacity and could not add to waitlist: " + waitlistError;
-            return false;
-        }
+        enqueueWaitlistEntry(*shard, waitlistEntry);
+        errorMessage = "Court is at maximum capacity. You have been added to the waitlist.";
+        return false;
     }
 
-    for (const auto& pair : bookingsById) {
-        const Booking& existingBooking = pair.second;
-
-        if (existingBooking.isCancelled()) {
-            continue;
-        }
+    if (dayBookings) {
+        for (const auto& entry : *dayBookings) {
+            const Booking& existingBooking = shard->bookings.at(entry.second);
 
-        if (existingBooking.getUserId() == userId &&
-            existingBooking.getCourtId() == courtId &&
-            existingBooking.getStartTime().date() == startTime.date()) {
+            if (existingBooking.getUserId() != userId) {
+                continue;
+            }
 
             bool timeOverlap = false;
             QDateTime bookingStart = existingBooking.getStartTime();
@@ -542,26 +527,22 @@ bool PadelDataManager::createBooking(int userId, int courtId, const QDateTime& s
         }
     }
 
-    User user;
-
     if (!memberDataManager) {
         errorMessage = "Member data manager is not set";
         return false;
     }
 
-    UserDataManager* userManager = memberDataManager->getUserDataManager();
     if (!userManager) {
         errorMessage = "User data manager is not set";
         return false;
     }
 
-    user = userManager->getUserDataById(userId);
     if (user.getId() <= 0) {
         errorMessage = "User not found with ID: " + QString::number(userId);
         return false;
     }
 
-    int bookingId = generateBookingId();
+    int bookingId = reserveBookingId(courtId);
 
     Booking newBooking;
     newBooking.setBookingId(bookingId);
@@ -570,26 +551,18 @@ bool PadelDataManager::createBooking(int userId, int courtId, const QDateTime& s
     newBooking.setEndTime(endTime);
     newBooking.setUserId(userId);
     newBooking.setIsFromWaitlist(isFromWaitlist);
-
-    bool isVip = false;
-    if (memberDataManager->userIsMember(userId)) {
-        int memberId = memberDataManager->getMemberIdByUserId(userId);
-        isVip = memberDataManager->isVIPMember(memberId);
-    }
-
-    double price = calculateBookingPrice(courtId, startTime, endTime, isVip);
     newBooking.setPrice(price);
     newBooking.setVip(isVip);
 
-    bookingsById[bookingId] = newBooking;
+    shard->bookings[bookingId] = newBooking;
+    indexBooking(*shard, newBooking);
     dataModified = true;
+    journalBooking(newBooking);
 
     QMetaObject::invokeMethod(this, "safeEmitBookingCreated",
                           Qt::QueuedConnection,
                           Q_ARG(int, bookingId),
                           Q_ARG(int, userId));
-
-    saveToFile();
     
     return true;
 }
@@ -602,13 +575,12 @@ double PadelDataManager::calculateBookingPrice(int courtId, const QDateTime& sta
                                              const QDateTime& endTime, bool isVIP) const {
     double pricePerHour = 100.0;
 
-    bool locked = mutex.tryLock(100);
-    if (locked) {
+    {
+        QReadLocker locker(&courtsLock);
         auto it = courtsById.find(courtId);
         if (it != courtsById.end()) {
             pricePerHour = it->second.getPricePerHour();
         }
-        mutex.unlock();
     }
 
     int durationInSeconds = startTime.secsTo(endTime);
@@ -624,81 +596,88 @@ double PadelDataManager::calculateBookingPrice(int courtId, const QDateTime& sta
 }
 
 bool PadelDataManager::deleteBooking(int bookingId, QString& errorMessage) {
-    QMutexLocker locker(&mutex);
+    CourtShard* shard = shardForBooking(bookingId);
+    if (!shard) {
+        errorMessage = "Booking not found";
+        return false;
+    }
 
-    auto it = bookingsById.find(bookingId);
-    if (it == bookingsById.end()) {
+    QWriteLocker locker(&shard->lock);
+
+    auto it = shard->bookings.find(bookingId);
+    if (it == shard->bookings.end()) {
         errorMessage = "Booking not found";
         return false;
     }
 
-    bookingsById.erase(it);
+    unindexBooking(*shard, it->second);
+    shard->bookings.erase(it);
+    {
+        QWriteLocker directoryLocker(&bookingCourtsLock);
+        bookingCourts.erase(bookingId);
+    }
     dataModified = true;
+    journalBookingDeleted(bookingId);
     return true;
 }
 
 bool PadelDataManager::cancelBooking(int bookingId, QString& errorMessage) {
-    bool locked = mutex.tryLock(200);
-
-    if (!locked) {
-        errorMessage = "System busy, please try again";
+    CourtShard* shard = shardForBooking(bookingId);
+    if (!shard) {
+        errorMessage = "Booking not found";
         return false;
     }
 
-    bool result = false;
     int courtId = -1;
     QDateTime startTime, endTime;
 
-    auto it = bookingsById.find(bookingId);
-    if (it == bookingsById.end()) {
-        errorMessage = "Booking not found";
-        mutex.unlock();
-        return false;
-    }
+    {
+        QWriteLocker locker(&shard->lock);
 
-    if (it->second.isCancelled()) {
-        errorMessage = "Booking is already cancelled";
-        mutex.unlock();
-        return false;
-    }
+        auto it = shard->bookings.find(bookingId);
+        if (it == shard->bookings.end()) {
+            errorMessage = "Booking not found";
+            return false;
+        }
 
-    QDateTime now = QDateTime::currentDateTime();
-    const Booking& booking = it->second;
-    bool canCancel = now.secsTo(booking.getStartTime()) >= 3 * 60 * 60;
+        if (it->second.isCancelled()) {
+            errorMessage = "Booking is already cancelled";
+            return false;
+        }
 
-    if (!canCancel) {
-        errorMessage = "Cancellation is not allowed within 3 hours of booking time";
-        mutex.unlock();
-        return false;
-    }
+        QDateTime now = QDateTime::currentDateTime();
+        Booking& booking = it->second;
+        bool canCancel = now.secsTo(booking.getStartTime()) >= 3 * 60 * 60;
 
-    courtId = booking.getCourtId();
-    startTime = booking.getStartTime();
-    endTime = booking.getEndTime();
+        if (!canCancel) {
+            errorMessage = "Cancellation is not allowed within 3 hours of booking time";
+            return false;
+        }
 
-    Booking& bookingRef = it->second;
-    bookingRef.cancel();
+        courtId = booking.getCourtId();
+        startTime = booking.getStartTime();
+        endTime = booking.getEndTime();
 
-    int memberId = bookingRef.getUserId();
+        unindexBooking(*shard, booking);
+        booking.cancel();
 
-    dataModified = true;
-    result = true;
+        int memberId = booking.getUserId();
 
-    QMetaObject::invokeMethod(this, "safeEmitBookingCancelled",
-                          Qt::QueuedConnection,
-                          Q_ARG(int, bookingId),
-                          Q_ARG(int, memberId));
+        dataModified = true;
+        journalBooking(booking);
 
-    mutex.unlock();
+        QMetaObject::invokeMethod(this, "safeEmitBookingCancelled",
+                              Qt::QueuedConnection,
+                              Q_ARG(int, bookingId),
+                              Q_ARG(int, memberId));
+    }
 
-    if (result && courtId > 0 && startTime.isValid() && endTime.isValid()) {
+    if (courtId > 0 && startTime.isValid() && endTime.isValid()) {
         QString waitlistError;
-        if (tryFillSlotFromWaitlist(courtId, startTime, endTime, waitlistError)) {
-        }
+        tryFillSlotFromWaitlist(courtId, startTime, endTime, waitlistError);
     }
 
-    saveToFile();
-    return result;
+    return true;
 }
 
 void PadelDataManager::safeEmitBookingCancelled(int bookingId, int userId) {
@@ -707,174 +686,245 @@ void PadelDataManager::safeEmitBookingCancelled(int bookingId, int userId) {
 
 bool PadelDataManager::rescheduleBooking(int bookingId, const QDateTime& newStartTime,
                                        const QDateTime& newEndTime, QString& errorMessage) {
-    bool locked = mutex.tryLock(200);
-
-    if (!locked) {
-        errorMessage = "System busy, please try again";
+    CourtShard* shard = shardForBooking(bookingId);
+    if (!shard) {
+        errorMessage = "Booking not found";
         return false;
     }
 
-    bool result = false;
     int courtId = -1;
+    int userId = -1;
     QDateTime oldStartTime, oldEndTime;
 
-    auto it = bookingsById.find(bookingId);
-    if (it == bookingsById.end()) {
-        errorMessage = "Booking not found";
-        mutex.unlock();
-        return false;
-    }
+    {
+        QWriteLocker locker(&shard->lock);
 
-    Booking& booking = it->second;
-    QDateTime now = QDateTime::currentDateTime();
+        auto it = shard->bookings.find(bookingId);
+        if (it == shard->bookings.end()) {
+            errorMessage = "Booking not found";
+            return false;
+        }
 
-    courtId = booking.getCourtId();
-    oldStartTime = booking.getStartTime();
-    oldEndTime = booking.getEndTime();
+        Booking& booking = it->second;
+        QDateTime now = QDateTime::currentDateTime();
 
-    if (now.secsTo(booking.getStartTime()) < 3 * 60 * 60) {
-        errorMessage = "Cannot reschedule booking less than 3 hours before start time";
-        mutex.unlock();
-        return false;
-    }
+        courtId = booking.getCourtId();
+        userId = booking.getUserId();
+        oldStartTime = booking.getStartTime();
+        oldEndTime = booking.getEndTime();
 
-    if (!validateBookingTime(newStartTime, newEndTime, errorMessage)) {
-        mutex.unlock();
-        return false;
-    }
-
-    bool available = true;
-    for (const auto& pair : bookingsById) {
-        const Booking& existingBooking = pair.second;
+        if (now.secsTo(booking.getStartTime()) < 3 * 60 * 60) {
+            errorMessage = "Cannot reschedule booking less than 3 hours before start time";
+            return false;
+        }
 
-        if (existingBooking.isCancelled() || existingBooking.getBookingId() == bookingId) {
-            continue;
+        if (!validateBookingTime(newStartTime, newEndTime, errorMessage)) {
+            return false;
         }
 
-        if (existingBooking.getCourtId() == courtId) {
-            if (!(newEndTime <= existingBooking.getStartTime() ||
-                  newStartTime >= existingBooking.getEndTime())) {
-                available = false;
-                break;
+        for (int overlappingId : findOverlappingBookingIds(*shard, newStartTime, newEndTime)) {
+            if (overlappingId != bookingId) {
+                errorMessage = "Court is not available at the requested time";
+                return false;
             }
         }
-    }
 
-    if (!available) {
-        errorMessage = "Court is not available at the requested time";
-        mutex.unlock();
-        return false;
+        unindexBooking(*shard, booking);
+        booking.setStartTime(newStartTime);
+        booking.setEndTime(newEndTime);
+        indexBooking(*shard, booking);
+        dataModified = true;
+        journalBooking(booking);
     }
 
-    booking.setStartTime(newStartTime);
-    booking.setEndTime(newEndTime);
-    dataModified = true;
-    result = true;
-
-    emit bookingRescheduled(bookingId, booking.getUser().getId());
-
-    mutex.unlock();
+    emit bookingRescheduled(bookingId, userId);
 
-    if (result && courtId > 0 && oldStartTime.isValid() && oldEndTime.isValid()) {
+    if (courtId > 0 && oldStartTime.isValid() && oldEndTime.isValid()) {
         QString waitlistError;
         tryFillSlotFromWaitlist(courtId, oldStartTime, oldEndTime, waitlistError);
     }
 
-    saveToFile();
-    return result;
+    return true;
 }
 
 QVector<Booking> PadelDataManager::getBookingsByMember(int memberId) const {
-    QMutexLocker locker(&mutex);
-
     QVector<Booking> result;
-    for (const auto& pair : bookingsById) {
-        if (pair.second.getMemberId() == memberId) {
-            result.append(pair.second);
+    for (CourtShard* shard : allShards()) {
+        QReadLocker locker(&shard->lock);
+        for (const auto& pair : shard->bookings) {
+            if (pair.second.getMemberId() == memberId) {
+                result.append(pair.second);
+            }
         }
     }
     return result;
 }
 
 QVector<Booking> PadelDataManager::getBookingsByCourt(int courtId) const {
-    QMutexLocker locker(&mutex);
-
     QVector<Booking> result;
-    for (const auto& pair : bookingsById) {
-        if (pair.second.getCourt().getId() == courtId) {
-            result.append(pair.second);
-        }
+
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
+        return result;
+    }
+
+    QReadLocker locker(&shard->lock);
+    result.reserve(static_cast<int>(shard->bookings.size()));
+    for (const auto& pair : shard->bookings) {
+        result.append(pair.second);
     }
     return result;
 }
 
 QVector<Booking> PadelDataManager::getBookingsByDate(const QDate& date) const {
-    QMutexLocker locker(&mutex);
-
     QVector<Booking> result;
-    for (const auto& pair : bookingsById) {
-        const Booking& booking = pair.second;
-        if (booking.getStartTime().date() == date) {
-            result.append(booking);
+    for (CourtShard* shard : allShards()) {
+        QReadLocker locker(&shard->lock);
+        for (const auto& pair : shard->bookings) {
+            const Booking& booking = pair.second;
+            if (booking.getStartTime().date() == date) {
+                result.append(booking);
+            }
         }
     }
     return result;
 }
 
 QVector<Booking> PadelDataManager::getBookingsForTimeSlot(int courtId, const QDateTime& startTime, const QDateTime& endTime) {
-    QMutexLocker locker(&mutex);
     QVector<Booking> results;
 
-    for (const auto& pair : bookingsById) {
-        const Booking& b = pair.second;
-        if (!b.isCancelled() &&
-            b.getCourtId() == courtId &&
-            b.getStartTime() < endTime &&
-            b.getEndTime() > startTime) {
-            results.append(b);
-            }
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
+        return results;
+    }
+
+    QReadLocker locker(&shard->lock);
+    const QVector<int> bookingIds = findOverlappingBookingIds(*shard, startTime, endTime);
+    results.reserve(bookingIds.size());
+    for (int bookingId : bookingIds) {
+        results.append(shard->bookings.at(bookingId));
     }
     return results;
 }
 
 bool PadelDataManager::isCourtAvailable(int courtId, const QDateTime& startTime,
                                       const QDateTime& endTime) const {
-    QMutexLocker locker(&mutex);
+    int maxAttendees;
+    {
+        QReadLocker courtsLocker(&courtsLock);
 
-    auto courtIt = courtsById.find(courtId);
-    if (courtIt == courtsById.end()) {
-        return false;
+        auto courtIt = courtsById.find(courtId);
+        if (courtIt == courtsById.end()) {
+            return false;
+        }
+        maxAttendees = courtIt->second.getMaxAttendees();
     }
 
-    const Court& court = courtIt->second;
-    int maxAttendees = court.getMaxAttendees();
-
     if (!startTime.isValid() || !endTime.isValid() || startTime >= endTime) {
         return false;
     }
 
-    int currentBookings = 0;
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
+        return false;
+    }
 
-    for (const auto& pair : bookingsById) {
-        const Booking& booking = pair.second;
+    QReadLocker locker(&shard->lock);
 
-        if (booking.isCancelled()) {
-            continue;
-        }
+    int currentBookings = 0;
+    const qint32 start = Booking::toEpochMinutes(startTime);
+    const qint32 end = Booking::toEpochMinutes(endTime);
 
-        if (booking.getCourtId() != courtId) {
+    for (QDate day = startTime.date(); day <= endTime.date(); day = day.addDays(1)) {
+        const std::multimap<qint32, int>* dayBookings = bookingsOnDay(*shard, day);
+        if (!dayBookings) {
             continue;
         }
 
         // Check if the booking is for the same time slot
-        if (booking.getStartTime() >= startTime && booking.getEndTime() <= endTime) {
-            currentBookings++;
+        auto last = dayBookings->upper_bound(end);
+        for (auto entryIt = dayBookings->lower_bound(start); entryIt != last; ++entryIt) {
+            if (shard->bookings.at(entryIt->second).getEndMinutes() <= end) {
+                currentBookings++;
+            }
         }
     }
 
     return (currentBookings < maxAttendees);
 }
 
+WeekOccupancy PadelDataManager::getWeekOccupancy(int courtId, const QDate& weekStart, int userId,
+                                                const QTime& firstSlot, int slotsPerDay) const {
+    WeekOccupancy occupancy;
+    occupancy.weekStart = weekStart;
+    occupancy.firstSlot = firstSlot;
+    occupancy.slotsPerDay = qMax(0, slotsPerDay);
+    occupancy.cells.resize(7 * occupancy.slotsPerDay);
+    occupancy.maxAttendees = Court().getMaxAttendees();
+
+    if (courtId <= 0 || !weekStart.isValid() || !firstSlot.isValid() || occupancy.slotsPerDay == 0) {
+        return occupancy;
+    }
+
+    {
+        QReadLocker courtsLocker(&courtsLock);
+
+        auto courtIt = courtsById.find(courtId);
+        if (courtIt == courtsById.end()) {
+            return occupancy;
+        }
+        occupancy.maxAttendees = courtIt->second.getMaxAttendees();
+    }
+
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
+        return occupancy;
+    }
+
+    QReadLocker locker(&shard->lock);
+
+    constexpr qint32 slotMinutes = 60;
+    qint32 dayStarts[7];
+    for (int day = 0; day < 7; ++day) {
+        dayStarts[day] = Booking::toEpochMinutes(QDateTime(weekStart.addDays(day), firstSlot));
+    }
+
+    // One pass over the week's bookings; each booking marks every cell it overlaps
+    const auto& days = shard->bookingsByDay;
+    for (auto dayIt = days.lower_bound(weekStart.addDays(-1));
+         dayIt != days.end() && dayIt->first < weekStart.addDays(7); ++dayIt) {
+        for (const auto& entry : dayIt->second) {
+            const Booking& booking = shard->bookings.at(entry.second);
+            const qint32 bookingStart = entry.first;
+            const qint32 bookingEnd = booking.getEndMinutes();
+            const bool ownBooking = (userId > 0 && booking.getUserId() == userId);
+
+            for (int day = 0; day < 7; ++day) {
+                const qint32 gridStart = dayStarts[day];
+                const qint32 gridEnd = gridStart + occupancy.slotsPerDay * slotMinutes;
+                if (bookingEnd <= gridStart || bookingStart >= gridEnd) {
+                    continue;
+                }
+
+                int firstCell = qMax(0, (bookingStart - gridStart) / slotMinutes);
+                int lastCell = qMin(occupancy.slotsPerDay,
+                                    (bookingEnd - gridStart + slotMinutes - 1) / slotMinutes);
+
+                for (int slot = firstCell; slot < lastCell; ++slot) {
+                    SlotOccupancy& cell = occupancy.cells[day * occupancy.slotsPerDay + slot];
+                    cell.attendees++;
+                    if (ownBooking) {
+                        cell.isBookedByUser = true;
+                        cell.userBookingId = booking.getBookingId();
+                    }
+                }
+            }
+        }
+    }
+
+    return occupancy;
+}
+
 bool PadelDataManager::validateCourtAvailability(int courtId, const QDateTime& startTime,
                                               const QDateTime& endTime) const {
     return isCourtAvailable(courtId, startTime, endTime);
@@ -887,11 +937,29 @@ bool PadelDataManager::addToWaitlist(int userId, int courtId, const QDateTime& r
         return false;
     }
 
-    if (courtsById.find(courtId) == courtsById.end()) {
+    {
+        QReadLocker courtsLocker(&courtsLock);
+        if (courtsById.find(courtId) == courtsById.end()) {
+            errorMessage = "Court not found.";
+            return false;
+        }
+    }
+
+    const WaitlistEntry entry = makeWaitlistEntry(userId, courtId, requestedTime);
+
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         errorMessage = "Court not found.";
         return false;
     }
 
+    QWriteLocker locker(&shard->lock);
+    enqueueWaitlistEntry(*shard, entry);
+
+    return true;
+}
+
+WaitlistEntry PadelDataManager::makeWaitlistEntry(int userId, int courtId, const QDateTime& requestedTime) const {
     bool isVIP = false;
     int priority = 0;
 
@@ -917,55 +985,43 @@ bool PadelDataManager::addToWaitlist(int userId, int courtId, const QDateTime& r
     entry.requestedTime = requestedTime;
     entry.isVIP = isVIP;
     entry.priority = priority;
+    return entry;
+}
 
-    if (courtWaitlists.find(courtId) == courtWaitlists.end()) {
-        courtWaitlists[courtId] = std::queue<WaitlistEntry>();
-    }
-
-    courtWaitlists[courtId].push(entry);
+void PadelDataManager::enqueueWaitlistEntry(CourtShard& shard, const WaitlistEntry& entry) {
+    shard.waitlist.push(entry);
     dataModified = true;
 
-    saveToFile();
-    updateWaitlistPositionsAndNotify(courtId);
-
-    return true;
+    journalWaitlist(entry.courtId, shard.waitlist);
+    updateWaitlistPositionsAndNotify(entry.courtId);
 }
 
 bool PadelDataManager::removeFromWaitlist(int userId, int courtId, QString& errorMessage) {
-    auto it = courtWaitlists.find(courtId);
-    if (it == courtWaitlists.end()) {
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         errorMessage = "No waitlist found for this court";
         return false;
     }
 
-    std::queue<WaitlistEntry>& waitlist = it->second;
-    std::queue<WaitlistEntry> newWaitlist;
-
-    bool found = false;
-    while (!waitlist.empty()) {
-        WaitlistEntry entry = waitlist.front();
-        waitlist.pop();
+    {
+        QWriteLocker locker(&shard->lock);
 
-        if (entry.memberId != userId) {
-            newWaitlist.push(entry);
-        } else {
-            found = true;
+        if (shard->waitlist.empty()) {
+            errorMessage = "No waitlist found for this court";
+            return false;
         }
-    }
 
-    if (!found) {
-        errorMessage = "User not found in waitlist";
-        return false;
-    }
+        if (shard->waitlist.removeMember(userId) == 0) {
+            errorMessage = "User not found in waitlist";
+            return false;
+        }
 
-    courtWaitlists[courtId] = newWaitlist;
-    dataModified = true;
+        dataModified = true;
 
-    if (newWaitlist.empty()) {
-        courtWaitlists.erase(courtId);
+        journalWaitlist(courtId, shard->waitlist);
+        updateWaitlistPositionsAndNotify(courtId);
     }
 
-    saveToFile();
     emit waitlistUpdated(courtId);
 
     return true;
@@ -973,31 +1029,39 @@ bool PadelDataManager::removeFromWaitlist(int userId, int courtId, QString& erro
 
 QVector<WaitlistEntry> PadelDataManager::getWaitlistForCourt(int courtId) const {
 
-    auto it = courtWaitlists.find(courtId);
-    if (it == courtWaitlists.end()) {
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         return QVector<WaitlistEntry>();
     }
 
-    QVector<WaitlistEntry> result;
-    std::queue<WaitlistEntry> tempQueue = it->second;
+    QReadLocker locker(&shard->lock);
 
-    while (!tempQueue.empty()) {
-        result.append(tempQueue.front());
-        tempQueue.pop();
+    QVector<WaitlistEntry> result;
+    result.reserve(static_cast<int>(shard->waitlist.size()));
+    for (const WaitlistEntry& entry : shard->waitlist) {
+        result.append(entry);
     }
 
     return result;
 }
 
 bool PadelDataManager::processWaitlist(int courtId, QString& errorMessage) {
-    auto it = courtWaitlists.find(courtId);
-    if (it == courtWaitlists.end() || it->second.empty()) {
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         errorMessage = "No waitlist entries for this court";
         return false;
     }
 
-    WaitlistEntry entry = it->second.front();
-    it->second.pop();
+    WaitlistEntry entry;
+    {
+        QWriteLocker locker(&shard->lock);
+        if (shard->waitlist.empty()) {
+            errorMessage = "No waitlist entries for this court";
+            return false;
+        }
+
+        entry = shard->waitlist.takeFront();
+    }
 
     int userId = entry.memberId;
 
@@ -1009,29 +1073,31 @@ bool PadelDataManager::processWaitlist(int courtId, QString& errorMessage) {
                                    bookingError,
                                    true);
 
+        QWriteLocker locker(&shard->lock);
         if (success) {
-            if (it->second.empty()) {
-                courtWaitlists.erase(it);
-            }
-
             dataModified = true;
-            saveToFile();
+            journalWaitlist(courtId, shard->waitlist);
+            updateWaitlistPositionsAndNotify(courtId);
 
             return true;
         } else {
             errorMessage = "Failed to create booking: " + bookingError;
-            it->second.push(entry);
+            shard->waitlist.push(entry);
             return false;
         }
     }
 
-    it->second.push(entry);
+    QWriteLocker locker(&shard->lock);
+    shard->waitlist.push(entry);
     errorMessage = "Court not available at the requested time";
     return false;
 }
 
 void PadelDataManager::setVIPPriority(int memberId, bool isVIP) {
-    vipMembers[memberId] = isVIP;
+    {
+        QWriteLocker locker(&courtsLock);
+        vipMembers[memberId] = isVIP;
+    }
     dataModified = true;
     emit vipStatusChanged(memberId, isVIP);
 }
@@ -1041,6 +1107,7 @@ bool PadelDataManager::isVIPMember(int memberId) const {
         return false;
     }
 
+    QReadLocker locker(&courtsLock);
     auto it = vipMembers.find(memberId);
     bool isVip = (it != vipMembers.end() && it->second);
     return isVip;
@@ -1056,6 +1123,7 @@ int PadelDataManager::calculatePriority(int memberId) const {
 }
 
 bool PadelDataManager::addTimeSlot(int courtId, const QTime& timeSlot, QString& errorMessage) {
+    QWriteLocker locker(&courtsLock);
 
     auto it = courtsById.find(courtId);
     if (it == courtsById.end()) {
@@ -1079,6 +1147,7 @@ bool PadelDataManager::addTimeSlot(int courtId, const QTime& timeSlot, QString&
 }
 
 bool PadelDataManager::removeTimeSlot(int courtId, const QTime& timeSlot, QString& errorMessage) {
+    QWriteLocker locker(&courtsLock);
 
     auto it = courtsById.find(courtId);
     if (it == courtsById.end()) {
@@ -1095,12 +1164,14 @@ bool PadelDataManager::removeTimeSlot(int courtId, const QTime& timeSlot, QStrin
         return false;
     }
 
-    for (const auto& pair : bookingsById) {
-        const Booking& booking = pair.second;
-        if (booking.getCourt().getId() == courtId &&
-            booking.getStartTime().time() == timeSlot) {
-            errorMessage = "Cannot remove time slot with existing bookings";
-            return false;
+    auto shardIt = shards.find(courtId);
+    if (shardIt != shards.end()) {
+        QReadLocker shardLocker(&shardIt->second->lock);
+        for (const auto& pair : shardIt->second->bookings) {
+            if (pair.second.getStartTime().time() == timeSlot) {
+                errorMessage = "Cannot remove time slot with existing bookings";
+                return false;
+            }
         }
     }
 
@@ -1113,19 +1184,10 @@ QVector<WaitlistEntry> PadelDataManager::getWaitlistForMember(int memberId) cons
 
     QVector<WaitlistEntry> result;
 
-    for (const auto& pair : courtWaitlists) {
-        int courtId = pair.first;
-        std::queue<WaitlistEntry> tempQueue = pair.second;
-
-        while (!tempQueue.empty()) {
-            WaitlistEntry entry = tempQueue.front();
-            tempQueue.pop();
-
-            if (entry.memberId == memberId) {
-
-                entry.courtId = courtId;
-                result.append(entry);
-            }
+    for (CourtShard* shard : allShards()) {
+        QReadLocker locker(&shard->lock);
+        for (const WaitlistEntry& entry : shard->waitlist.entriesForMember(memberId)) {
+            result.append(entry);
         }
     }
 
@@ -1137,47 +1199,20 @@ int PadelDataManager::getWaitlistPosition(int userId, int courtId) const {
         return -1;
     }
 
-    auto courtIt = courtsById.find(courtId);
-    if (courtIt == courtsById.end()) {
-        return -1;
-    }
-
-    auto it = courtWaitlists.find(courtId);
-    if (it == courtWaitlists.end()) {
-        return -1;
-    }
-
-    if (it->second.empty()) {
-        return -1;
-    }
-
-    QVector<WaitlistEntry> entries;
-    std::queue<WaitlistEntry> tempQueue = it->second;
-
-    while (!tempQueue.empty()) {
-        entries.append(tempQueue.front());
-        tempQueue.pop();
+    {
+        QReadLocker courtsLocker(&courtsLock);
+        if (courtsById.find(courtId) == courtsById.end()) {
+            return -1;
+        }
     }
 
-    if (entries.isEmpty()) {
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         return -1;
     }
 
-    std::sort(entries.begin(), entries.end(), [](const WaitlistEntry& a, const WaitlistEntry& b) {
-        if (a.isVIP != b.isVIP) {
-            return a.isVIP;
-        }
-        return a.priority > b.priority;
-    });
-
-    for (int i = 0; i < entries.size(); ++i) {
-        if (entries[i].memberId == userId) {
-            int position = i + 1;
-            return position;
-        }
-    }
-
-    return -1;
+    QReadLocker locker(&shard->lock);
+    return shard->waitlist.position(userId);
 }
 
 void PadelDataManager::removeUserFromAllWaitlists(int userId, int courtId, const QDate& date) {
@@ -1185,40 +1220,31 @@ void PadelDataManager::removeUserFromAllWaitlists(int userId, int courtId, const
         return;
     }
 
-    auto courtIt = courtsById.find(courtId);
-    if (courtIt == courtsById.end()) {
-        return;
-    }
-
-    auto it = courtWaitlists.find(courtId);
-    if (it == courtWaitlists.end() || it->second.empty()) {
-        return;
+    {
+        QReadLocker courtsLocker(&courtsLock);
+        if (courtsById.find(courtId) == courtsById.end()) {
+            return;
+        }
     }
 
-    std::queue<WaitlistEntry> newQueue;
-    std::queue<WaitlistEntry> tempQueue = it->second;
-
-    if (tempQueue.empty()) {
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         return;
     }
 
-    while (!tempQueue.empty()) {
-        WaitlistEntry entry = tempQueue.front();
-        tempQueue.pop();
+    {
+        QWriteLocker locker(&shard->lock);
 
-        if (entry.memberId != userId || entry.courtId != courtId || entry.requestedTime.date() != date) {
-            newQueue.push(entry);
+        if (shard->waitlist.removeMemberOnDate(userId, date) == 0) {
+            return;
         }
-    }
 
-    if (newQueue.empty()) {
-        courtWaitlists.erase(courtId);
-    } else {
-        courtWaitlists[courtId] = newQueue;
+        dataModified = true;
+        journalWaitlist(courtId, shard->waitlist);
+        updateWaitlistPositionsAndNotify(courtId);
     }
 
     emit waitlistUpdated(courtId);
-    dataModified = true;
 }
 
 void PadelDataManager::updateWaitlistPositionsAndNotify(int courtId) {
@@ -1226,44 +1252,63 @@ void PadelDataManager::updateWaitlistPositionsAndNotify(int courtId) {
         return;
     }
 
-    if (courtsById.find(courtId) == courtsById.end()) {
-        return;
+    QMutexLocker locker(&notificationMutex);
+    if (pendingPositionCourts.isEmpty()) {
+        QMetaObject::invokeMethod(this, "flushWaitlistPositionUpdates", Qt::QueuedConnection);
     }
+    pendingPositionCourts.insert(courtId);
+}
 
-    auto waitlistIt = courtWaitlists.find(courtId);
-    if (waitlistIt == courtWaitlists.end()) {
-        return;
-    }
+void PadelDataManager::flushWaitlistPositionUpdates() {
+    QHash<int, QHash<int, int>> changesByCourt;
 
-    if (waitlistIt->second.empty()) {
-        return;
+    QSet<int> courts;
+    {
+        QMutexLocker locker(&notificationMutex);
+        courts = std::exchange(pendingPositionCourts, QSet<int>());
     }
 
-    QVector<WaitlistEntry> entries;
-    std::queue<WaitlistEntry> tempQueue = waitlistIt->second;
-    
-    while (!tempQueue.empty()) {
-        entries.append(tempQueue.front());
-        tempQueue.pop();
-    }
+    // notifiedWaitlistPositions is only touched here, on the manager's own thread
+    for (int courtId : courts) {
+        QHash<int, int> current;
+        if (CourtShard* shard = shardFor(courtId)) {
+            QReadLocker locker(&shard->lock);
+            int position = 1;
+            for (const WaitlistEntry& entry : shard->waitlist) {
+                // A user's position is that of their first entry
+                if (!current.contains(entry.memberId)) {
+                    current.insert(entry.memberId, position);
+                }
+                position++;
+            }
+        }
 
-    dataModified = true;
+        const QHash<int, int> previous = notifiedWaitlistPositions.value(courtId);
+        QHash<int, int> changes;
+        for (auto it = current.cbegin(); it != current.cend(); ++it) {
+            if (previous.value(it.key(), -1) != it.value()) {
+                changes.insert(it.key(), it.value());
+            }
+        }
+        for (auto it = previous.cbegin(); it != previous.cend(); ++it) {
+            if (!current.contains(it.key())) {
+                changes.insert(it.key(), -1);
+            }
+        }
 
-    if (entries.isEmpty()) {
-        return;
-    }
+        if (current.isEmpty()) {
+            notifiedWaitlistPositions.remove(courtId);
+        } else {
+            notifiedWaitlistPositions.insert(courtId, current);
+        }
 
-    std::sort(entries.begin(), entries.end(), [](const WaitlistEntry& a, const WaitlistEntry& b) {
-        if (a.isVIP != b.isVIP) {
-            return a.isVIP > b.isVIP;
+        if (!changes.isEmpty()) {
+            changesByCourt.insert(courtId, changes);
         }
-        return a.priority > b.priority;
-    });
+    }
 
-    for (int i = 0; i < entries.size(); i++) {
-        int userId = entries[i].memberId;
-        int position = i + 1;
-        emit waitlistPositionChanged(userId, courtId, position);
+    for (auto it = changesByCourt.cbegin(); it != changesByCourt.cend(); ++it) {
+        emit waitlistPositionsChanged(it.key(), it.value());
     }
 }
 
@@ -1272,22 +1317,22 @@ bool PadelDataManager::userHasBookingAtTime(int userId, int courtId, const QDate
         return false;
     }
 
-    QMutexLocker locker(&mutex);
-
-    for (const auto& pair : bookingsById) {
-        const Booking& booking = pair.second;
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
+        return false;
+    }
 
-        if (booking.isCancelled()) {
-            continue;
-        }
+    QReadLocker locker(&shard->lock);
 
-        if (booking.getUserId() == userId &&
-            booking.getCourtId() == courtId &&
-            booking.getStartTime().date() == date) {
+    const std::multimap<qint32, int>* dayBookings = bookingsOnDay(*shard, date);
+    if (!dayBookings) {
+        return false;
+    }
 
-            if (booking.getStartTime().time() == timeSlot) {
-                return true;
-            }
+    auto range = dayBookings->equal_range(Booking::toEpochMinutes(QDateTime(date, timeSlot)));
+    for (auto entryIt = range.first; entryIt != range.second; ++entryIt) {
+        if (shard->bookings.at(entryIt->second).getUserId() == userId) {
+            return true;
         }
     }
 
@@ -1299,19 +1344,27 @@ bool PadelDataManager::userHasBookingOnDate(int userId, int courtId, const QDate
         return false;
     }
 
-    QMutexLocker locker(&mutex);
+    std::vector<CourtShard*> candidates;
+    if (courtId > 0) {
+        if (CourtShard* shard = shardFor(courtId)) {
+            candidates.push_back(shard);
+        }
+    } else {
+        candidates = allShards();
+    }
 
-    for (const auto& pair : bookingsById) {
-        const Booking& booking = pair.second;
+    for (CourtShard* shard : candidates) {
+        QReadLocker locker(&shard->lock);
 
-        if (booking.isCancelled()) {
+        const std::multimap<qint32, int>* dayBookings = bookingsOnDay(*shard, date);
+        if (!dayBookings) {
             continue;
         }
 
-        if (booking.getUserId() == userId &&
-            (courtId <= 0 || booking.getCourtId() == courtId) &&
-            booking.getStartTime().date() == date) {
-            return true;
+        for (const auto& entry : *dayBookings) {
+            if (shard->bookings.at(entry.second).getUserId() == userId) {
+                return true;
+            }
         }
     }
 
@@ -1320,17 +1373,20 @@ bool PadelDataManager::userHasBookingOnDate(int userId, int courtId, const QDate
 
 QVector<Booking> PadelDataManager::getUserAutoBookings(int userId) const {
     QVector<Booking> result;
-    QMutexLocker locker(&mutex);
 
-    for (const auto& pair : bookingsById) {
-        const Booking& booking = pair.second;
+    for (CourtShard* shard : allShards()) {
+        QReadLocker locker(&shard->lock);
 
-        if (booking.isCancelled()) {
-            continue;
-        }
+        for (const auto& pair : shard->bookings) {
+            const Booking& booking = pair.second;
 
-        if (booking.getUserId() == userId && booking.isFromWaitlist()) {
-            result.append(booking);
+            if (booking.isCancelled()) {
+                continue;
+            }
+
+            if (booking.getUserId() == userId && booking.isFromWaitlist()) {
+                result.append(booking);
+            }
         }
     }
 
@@ -1342,43 +1398,18 @@ bool PadelDataManager::isUserInWaitlist(int userId, int courtId, const QDateTime
         return false;
     }
 
-    bool locked = mutex.tryLock(100);
-    if (!locked) {
-        return false;
-    }
-
-    struct ScopedUnlock {
-        QMutex& m;
-        ScopedUnlock(QMutex& mutex) : m(mutex) {}
-        ~ScopedUnlock() { m.unlock(); }
-    } unlocker(mutex);
-
-    auto courtIt = courtsById.find(courtId);
-    if (courtIt == courtsById.end()) {
-        return false;
-    }
-
-    auto it = courtWaitlists.find(courtId);
-    if (it == courtWaitlists.end()) {
-        return false;
-    }
-
-    if (it->second.empty()) {
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         return false;
     }
 
-    std::queue<WaitlistEntry> tempQueue = it->second;
+    QReadLocker locker(&shard->lock);
 
-    if (tempQueue.empty()) {
+    if (!shard->waitlist.contains(userId)) {
         return false;
     }
 
-    while (!tempQueue.empty()) {
-        WaitlistEntry entry = tempQueue.front();
-        tempQueue.pop();
-
-        if (entry.memberId != userId) continue;
-
+    for (const WaitlistEntry& entry : shard->waitlist.entriesForMember(userId)) {
         if (!entry.requestedTime.isValid() ||
             !requestedTime.isValid() ||
             entry.requestedTime.date() != requestedTime.date()) {
@@ -1411,69 +1442,50 @@ QJsonObject PadelDataManager::getDetailedWaitlistInfo(int courtId, const QDate&
     QVector<WaitlistEntry> entries;
     QVector<User> users;
 
-    if (courtsById.find(courtId) == courtsById.end()) {
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         result["error"] = "Court not found";
         result["waitlistCount"] = 0;
         result["entries"] = QJsonArray();
         return result;
     }
 
-    auto it = courtWaitlists.find(courtId);
-    if (it == courtWaitlists.end() || it->second.empty()) {
+    {
+        QReadLocker locker(&shard->lock);
+        for (const WaitlistEntry& entry : shard->waitlist) {
+            if (entry.requestedTime.date() == date) {
+                entries.append(entry);
+            }
+        }
+    }
+
+    if (entries.isEmpty()) {
         result["waitlistCount"] = 0;
         result["entries"] = QJsonArray();
         return result;
     }
 
-    std::queue<WaitlistEntry> tempQueue = it->second;
-    while (!tempQueue.empty()) {
-        WaitlistEntry entry = tempQueue.front();
-        tempQueue.pop();
-
-        if (entry.requestedTime.date() == date) {
-            entries.append(entry);
-
-            if (memberDataManager) {
-                UserDataManager* userManager = memberDataManager->getUserDataManager();
-                if (userManager) {
-                    User user = userManager->getUserDataById(entry.memberId);
-                    if (user.getId() > 0) {
-                        users.append(user);
-                    }
+    // User lookups go through another manager, so they happen outside the shard lock
+    if (memberDataManager) {
+        UserDataManager* userManager = memberDataManager->getUserDataManager();
+        if (userManager) {
+            for (const WaitlistEntry& entry : entries) {
+                User user = userManager->getUserDataById(entry.memberId);
+                if (user.getId() > 0) {
+                    users.append(user);
                 }
             }
         }
     }
 
-    QVector<int> indices;
-    for (int i = 0; i < entries.size(); i++) {
-        indices.append(i);
-    }
-
-    std::sort(indices.begin(), indices.end(), [&entries](int a, int b) {
-        const WaitlistEntry& entryA = entries[a];
-        const WaitlistEntry& entryB = entries[b];
-
-        if (entryA.isVIP != entryB.isVIP) {
-            return entryA.isVIP;
-        }
-
-        if (entryA.priority != entryB.priority) {
-            return entryA.priority > entryB.priority;
-        }
-
-        return entryA.requestedTime < entryB.requestedTime;
-    });
-
     result["waitlistCount"] = entries.size();
 
     QJsonArray entriesArray;
-    for (int i = 0; i < indices.size(); i++) {
-        int idx = indices[i];
+    for (int idx = 0; idx < entries.size(); idx++) {
         const WaitlistEntry& entry = entries[idx];
 
         QJsonObject entryObj;
-        entryObj["position"] = i + 1;
+        entryObj["position"] = idx + 1;
         entryObj["userId"] = entry.memberId;
         entryObj["isVIP"] = entry.isVIP;
         entryObj["priority"] = entry.priority;
@@ -1493,23 +1505,12 @@ QJsonObject PadelDataManager::getDetailedWaitlistInfo(int courtId, const QDate&
 }
 
 QVector<WaitlistEntry> PadelDataManager::getWaitlistForUser(int userId) const {
-    QMutexLocker locker(&mutex);
-
     QVector<WaitlistEntry> result;
 
-    for (const auto& pair : courtWaitlists) {
-        int courtId = pair.first;
-        std::queue<WaitlistEntry> tempQueue = pair.second;
-
-        while (!tempQueue.empty()) {
-            WaitlistEntry entry = tempQueue.front();
-            tempQueue.pop();
-
-            if (entry.memberId == userId) {
-
-                entry.courtId = courtId;
-                result.append(entry);
-            }
+    for (CourtShard* shard : allShards()) {
+        QReadLocker locker(&shard->lock);
+        for (const WaitlistEntry& entry : shard->waitlist.entriesForMember(userId)) {
+            result.append(entry);
         }
     }
 
@@ -1517,7 +1518,7 @@ QVector<WaitlistEntry> PadelDataManager::getWaitlistForUser(int userId) const {
 }
 
 QVector<QTime> PadelDataManager::getAllTimeSlots(int courtId) const {
-    QMutexLocker locker(&mutex);
+    QReadLocker locker(&courtsLock);
 
     if (courtId <= 0) {
         return QVector<QTime>();
@@ -1572,32 +1573,184 @@ QJsonArray PadelDataManager::getAllTimeSlotsJson(int courtId) const {
     return timeSlotsArray;
 }
 
-QJsonArray PadelDataManager::waitlistsToJson() const {
-    QJsonArray waitlistsArray;
+QJsonObject PadelDataManager::waitlistEntryToJson(const WaitlistEntry& entry) {
+    QJsonObject entryObj;
+    entryObj["userId"] = entry.memberId;
+    entryObj["courtId"] = entry.courtId;
+    entryObj["requestedTime"] = entry.requestedTime.toString(Qt::ISODate);
+    entryObj["isVIP"] = entry.isVIP;
+    entryObj["priority"] = entry.priority;
+    return entryObj;
+}
+
+WaitlistEntry PadelDataManager::jsonToWaitlistEntry(const QJsonObject& json) {
+    WaitlistEntry entry;
+    if (json.contains("userId")) {
+        entry.memberId = json["userId"].toInt();
+    } else {
+        entry.memberId = json["memberId"].toInt();
+    }
+
+    entry.courtId = json["courtId"].toInt();
+    entry.requestedTime = QDateTime::fromString(json["requestedTime"].toString(), Qt::ISODate);
+    entry.isVIP = json["isVIP"].toBool();
+    entry.priority = json["priority"].toInt();
+    return entry;
+}
+
+bool PadelDataManager::appendToJournal(const QJsonObject& entry) {
+    QMutexLocker locker(&journalMutex);
+
+    bool written = journalFile.isOpen() || journalFile.open(QIODevice::WriteOnly | QIODevice::Append);
+
+    if (written) {
+        QByteArray line = QJsonDocument(entry).toJson(QJsonDocument::Compact);
+        line.append('\n');
+
+        written = journalFile.write(line) == line.size();
+        journalFile.flush();
+    }
+
+    // Callers hold shard locks, so fall back to a full snapshot from the event loop
+    if (!written || ++journalEntryCount >= JournalCompactionThreshold) {
+        QMetaObject::invokeMethod(this, [this]() { saveToFile(); }, Qt::QueuedConnection);
+    }
+    return written;
+}
+
+void PadelDataManager::journalBooking(const Booking& booking) {
+    QJsonObject entry;
+    entry["op"] = "booking";
+    entry["booking"] = bookingToJson(booking);
+
+    appendToJournal(entry);
+}
+
+void PadelDataManager::journalBookingDeleted(int bookingId) {
+    QJsonObject entry;
+    entry["op"] = "deleteBooking";
+    entry["id"] = bookingId;
+
+    appendToJournal(entry);
+}
+
+void PadelDataManager::journalWaitlist(int courtId, const CourtWaitlist& waitlist) {
+    QJsonArray entries;
+    for (WaitlistEntry waitlistEntry : waitlist) {
+        waitlistEntry.courtId = courtId;
+        entries.append(waitlistEntryToJson(waitlistEntry));
+    }
+
+    QJsonObject entry;
+    entry["op"] = "waitlist";
+    entry["courtId"] = courtId;
+    entry["entries"] = entries;
+
+    appendToJournal(entry);
+}
+
+bool PadelDataManager::replayJournal(QString& errorMessage) {
+    journalFile.close();
+    journalEntryCount = 0;
+
+    // Parked entries from an unfinished compaction are older than the live journal
+    QFile compactingFile(compactingJournalPath);
+    if (!replayJournalFile(compactingFile, errorMessage) || !replayJournalFile(journalFile, errorMessage)) {
+        return false;
+    }
+
+    if (journalEntryCount > 0) {
+        dataModified = true;
+    }
+    return true;
+}
+
+bool PadelDataManager::replayJournalFile(QFile& file, QString& errorMessage) {
+    if (!file.exists()) {
+        return true;
+    }
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = "Could not open padel journal for reading: " + file.errorString();
+        return false;
+    }
+
+    // Every operation is an idempotent upsert/erase, so replaying entries that were
+    // already folded into the snapshots is harmless.
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
 
-    for (const auto& pair : courtWaitlists) {
-        int courtId = pair.first;
-        std::queue<WaitlistEntry> tempQueue = pair.second;
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(line, &parseError);
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+            // Torn trailing write from an interrupted append
+            break;
+        }
 
-        while (!tempQueue.empty()) {
-            WaitlistEntry entry = tempQueue.front();
-            tempQueue.pop();
+        QJsonObject entry = doc.object();
+        QString op = entry["op"].toString();
 
-            QJsonObject entryObj;
-            entryObj["userId"] = entry.memberId;
-            entryObj["courtId"] = courtId;
-            entryObj["requestedTime"] = entry.requestedTime.toString(Qt::ISODate);
-            entryObj["isVIP"] = entry.isVIP;
-            entryObj["priority"] = entry.priority;
+        if (op == "booking") {
+            storeLoadedBooking(jsonToBooking(entry["booking"].toObject()));
+        } else if (op == "deleteBooking") {
+            eraseLoadedBooking(entry["id"].toInt());
+        } else if (op == "waitlist") {
+            int courtId = entry["courtId"].toInt();
+            CourtWaitlist waitlist;
+            for (const QJsonValue& entryValue : entry["entries"].toArray()) {
+                waitlist.push(jsonToWaitlistEntry(entryValue.toObject()));
+            }
 
-            waitlistsArray.append(entryObj);
+            ensureShard(courtId).waitlist = std::move(waitlist);
         }
+
+        journalEntryCount++;
+    }
+
+    file.close();
+    return true;
+}
+
+bool PadelDataManager::rotateJournal() {
+    QMutexLocker locker(&journalMutex);
+
+    journalFile.close();
+    journalEntryCount = 0;
+
+    if (!journalFile.exists()) {
+        return true;
+    }
+
+    if (!QFile::exists(compactingJournalPath)) {
+        return QFile::rename(journalFile.fileName(), compactingJournalPath);
+    }
+
+    // A previous snapshot is still in flight: keep its parked entries and add ours after them
+    QFile compactingFile(compactingJournalPath);
+    if (!journalFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QByteArray pending = journalFile.readAll();
+    journalFile.close();
+
+    if (!compactingFile.open(QIODevice::WriteOnly | QIODevice::Append) ||
+        compactingFile.write(pending) != pending.size()) {
+        return false;
     }
+    compactingFile.close();
 
-    return waitlistsArray;
+    return journalFile.remove();
 }
 
 QJsonArray PadelDataManager::readWaitlistsFromFile(QString& errorMessage) const {
+    QJsonArray snapshotArray;
+    if (BinarySnapshot::readJsonArrayIfPreferred(QDir(dataDir).filePath("waitlists.json"), snapshotArray)) {
+        return snapshotArray;
+    }
+
     QFile file(QDir(dataDir).filePath("waitlists.json"));
     if (!file.exists()) {
         return QJsonArray();
@@ -1622,78 +1775,149 @@ QJsonArray PadelDataManager::readWaitlistsFromFile(QString& errorMessage) const
     return doc.array();
 }
 
-bool PadelDataManager::writeWaitlistsToFile(const QJsonArray& waitlists, QString& errorMessage) const {
-    QString filePath = QDir(dataDir).filePath("waitlists.json");
-    QFile file(filePath);
-    QFileInfo fileInfo(filePath);
-    QDir().mkpath(fileInfo.absolutePath());
+bool PadelDataManager::writeWaitlistsToFile(std::vector<WaitlistEntry> waitlists, QString& errorMessage) const {
+    Q_UNUSED(errorMessage);
+    BinarySnapshot::scheduleJsonArrayWrites(QDir(dataDir).filePath("waitlists.json"),
+                                            [waitlists = std::move(waitlists)]() {
+        QJsonArray waitlistsArray;
+        for (const WaitlistEntry& entry : waitlists) {
+            waitlistsArray.append(waitlistEntryToJson(entry));
+        }
+        return waitlistsArray;
+    });
+    return true;
+}
+
+bool PadelDataManager::readBookingsSnapshot(QString& errorMessage) {
+    const QString jsonPath = QDir(dataDir).filePath("bookings.json");
+    if (!BinarySnapshot::isPreferred(jsonPath)) {
+        return false;
+    }
+
+    BinarySnapshot::Reader reader(BinarySnapshot::binaryPathFor(jsonPath));
+    if (!reader.isValid() || reader.schemaTag() != BookingSnapshotSchema) {
+        // Generic JSON records (e.g. produced by the converter) or an unreadable file
+        QJsonArray bookingsArray;
+        if (!BinarySnapshot::readJsonArrayIfPreferred(jsonPath, bookingsArray)) {
+            return false;
+        }
+        for (const QJsonValue& bookingValue : bookingsArray) {
+            storeLoadedBooking(jsonToBooking(bookingValue.toObject()));
+        }
+        return true;
+    }
+
+    bookingCourts.reserve(reader.recordCount());
+    const uchar* record = nullptr;
+    quint32 size = 0;
+    while (reader.nextRecord(record, size)) {
+        Booking booking;
+        if (decodeBookingRecord(record, size, booking)) {
+            storeLoadedBooking(booking);
+        }
+    }
 
-    if (!file.open(QIODevice::WriteOnly)) {
-        errorMessage = "Could not open waitlists file for writing: " + file.errorString();
+    if (!reader.isValid()) {
+        // A truncated snapshot is not trusted; fall back to the JSON file
+        errorMessage.clear();
+        clearLoadedBookings();
         return false;
     }
+    return true;
+}
 
-    QJsonDocument doc(waitlists);
-    QByteArray jsonData = doc.toJson(QJsonDocument::Indented);
+const bool PadelDataManager::bookingSnapshotRegistered =
+    BinarySnapshot::registerTypedSchema(BookingSnapshotSchema, &PadelDataManager::bookingRecordToJson);
 
-    qint64 bytesWritten = file.write(jsonData);
-    if (bytesWritten == -1) {
-        errorMessage = "Failed to write to waitlists file: " + file.errorString();
-        file.close();
+bool PadelDataManager::decodeBookingRecord(const uchar* record, quint32 size, Booking& booking) {
+    // id, court, user, start, end (qint32 each), price (double), flags (quint8)
+    constexpr quint32 MinimumRecordSize = 5 * 4 + 8 + 1;
+    if (size < MinimumRecordSize) {
         return false;
     }
 
-    file.flush();
-    file.close();
+    booking.setBookingId(qFromBigEndian<qint32>(record));
+    booking.setCourtId(qFromBigEndian<qint32>(record + 4));
+    booking.setUserId(qFromBigEndian<qint32>(record + 8));
+    booking.setStartMinutes(qFromBigEndian<qint32>(record + 12));
+    booking.setEndMinutes(qFromBigEndian<qint32>(record + 16));
+
+    const quint64 priceBits = qFromBigEndian<quint64>(record + 20);
+    double price;
+    std::memcpy(&price, &priceBits, sizeof(price));
+    booking.setPrice(price);
+
+    const quint8 flags = record[28];
+    booking.setVip(flags & 0x1);
+    booking.setCancelled(flags & 0x2);
+    booking.setIsFromWaitlist(flags & 0x4);
+    return true;
+}
+
+bool PadelDataManager::bookingRecordToJson(const uchar* record, quint32 size, QJsonObject& object) {
+    Booking booking;
+    if (!decodeBookingRecord(record, size, booking)) {
+        return false;
+    }
+    object = bookingToJson(booking);
     return true;
 }
 
+void PadelDataManager::writeBookingsSnapshot(std::shared_ptr<const std::vector<Booking>> bookings) const {
+    if (!BinarySnapshot::isEnabled()) {
+        return;
+    }
+
+    const QString binaryPath = BinarySnapshot::binaryPathFor(QDir(dataDir).filePath("bookings.json"));
+    PersistenceService::instance().scheduleWrite(binaryPath, [bookings = std::move(bookings)]() {
+        BinarySnapshot::Writer writer(BookingSnapshotSchema, BookingSnapshotVersion);
+        for (const Booking& booking : *bookings) {
+            QDataStream& stream = writer.beginRecord();
+            stream << qint32(booking.getBookingId()) << qint32(booking.getCourtId())
+                   << qint32(booking.getUserId()) << booking.getStartMinutes()
+                   << booking.getEndMinutes() << booking.getPrice();
+            stream << quint8((booking.isVip() ? 0x1 : 0) |
+                             (booking.isCancelled() ? 0x2 : 0) |
+                             (booking.isFromWaitlist() ? 0x4 : 0));
+            writer.endRecord();
+        }
+        return writer.finish();
+    });
+}
+
 bool PadelDataManager::tryFillSlotFromWaitlist(int courtId, const QDateTime& startTime, const QDateTime& endTime, QString& errorMessage) {
     if (courtId <= 0 || !startTime.isValid() || !endTime.isValid()) {
         errorMessage = "Invalid parameters in tryFillSlotFromWaitlist";
         return false;
     }
 
-    auto courtIt = courtsById.find(courtId);
-    if (courtIt == courtsById.end()) {
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         errorMessage = "Court not found in tryFillSlotFromWaitlist";
         return false;
     }
 
-    auto it = courtWaitlists.find(courtId);
-    if (it == courtWaitlists.end() || it->second.empty()) {
-        return false;
-    }
-
+    // Booking attempts take the shard lock themselves, so collect candidates first
     QVector<WaitlistEntry> entries;
-    std::queue<WaitlistEntry> tempQueue = it->second;
+    {
+        QReadLocker locker(&shard->lock);
+        for (const WaitlistEntry& entry : shard->waitlist) {
+            if (entry.requestedTime.date() != startTime.date()) {
+                continue;
+            }
 
-    while (!tempQueue.empty()) {
-        entries.append(tempQueue.front());
-        tempQueue.pop();
+            double hourDiff = std::abs(entry.requestedTime.secsTo(startTime)) / 3600.0;
+            if (hourDiff <= 3.0) {
+                entries.append(entry);
+            }
+        }
     }
 
     if (entries.isEmpty()) {
         return false;
     }
 
-    std::sort(entries.begin(), entries.end(), [](const WaitlistEntry& a, const WaitlistEntry& b) {
-        if (a.isVIP != b.isVIP) {
-            return a.isVIP > b.isVIP;
-        }
-        return a.priority > b.priority;
-    });
-
     for (const WaitlistEntry& entry : entries) {
-        if (entry.requestedTime.date() != startTime.date()) {
-            continue;
-        }
-
-        double hourDiff = std::abs(entry.requestedTime.secsTo(startTime)) / 3600.0;
-        if (hourDiff > 3.0) {
-            continue;
-        }
-
         int userId = entry.memberId;
 
         if (userHasBookingOnDate(userId, courtId, startTime.date())) {
@@ -1742,11 +1966,10 @@ void PadelDataManager::setMemberDataManager(MemberDataManager* memberManager) {
 
 QVector<Court> PadelDataManager::getAvailableCourts(const QDateTime& startTime, const QDateTime& endTime,
                                                   const QString& location) const {
-    QMutexLocker locker(&mutex);
     QVector<Court> availableCourts;
 
-    for (const auto& pair : courtsById) {
-        const Court& court = pair.second;
+    // isCourtAvailable() takes courtsLock itself, so check a copy of the catalogue
+    for (const Court& court : getAllCourts()) {
 
         if (court.getLocation() != location) {
             continue;
@@ -1761,69 +1984,40 @@ QVector<Court> PadelDataManager::getAvailableCourts(const QDateTime& startTime,
 }
 
 int PadelDataManager::getCurrentAttendees(int courtId, const QDateTime& startTime, const QDateTime& endTime) const {
-    QMutexLocker locker(&mutex);
-    int attendeeCount = 0;
-
     if (courtId <= 0 || !startTime.isValid() || !endTime.isValid()) {
         return 0;
     }
 
-    auto courtIt = courtsById.find(courtId);
-    if (courtIt == courtsById.end()) {
+    CourtShard* shard = shardFor(courtId);
+    if (!shard) {
         return 0;
     }
 
-    for (const auto& pair : bookingsById) {
-        const Booking& booking = pair.second;
-
-        if (booking.isCancelled()) {
-            continue;
-        }
-
-        if (booking.getCourtId() != courtId) {
-            continue;
-        }
-
-        QDateTime bookingStart = booking.getStartTime();
-        QDateTime bookingEnd = booking.getEndTime();
-
-        bool overlaps = (bookingStart < endTime && startTime < bookingEnd);
-
-        if (overlaps) {
-            attendeeCount++;
-        }
-    }
-
-    return attendeeCount;
+    QReadLocker locker(&shard->lock);
+    return findOverlappingBookingIds(*shard, startTime, endTime).size();
 }
 
 QVector<Booking> PadelDataManager::getAllBookings() const {
-    QMutexLocker locker(&mutex);
     QVector<Booking> allBookings;
 
-    allBookings.reserve(bookingsById.size());
-    for (const auto& pair : bookingsById) {
-        allBookings.append(pair.second);
+    for (CourtShard* shard : allShards()) {
+        QReadLocker locker(&shard->lock);
+        for (const auto& pair : shard->bookings) {
+            allBookings.append(pair.second);
+        }
     }
 
     return allBookings;
 }
 
 QJsonArray PadelDataManager::getAvailableTimeSlots(int courtId, const QDate& date, int maxAttendees) const {
-    bool locked = mutex.tryLock(200);
-    if (!locked) {
-        return QJsonArray();
-    }
-
     QJsonArray availableSlots;
 
     if (courtId <= 0) {
-        mutex.unlock();
         return availableSlots;
     }
 
     if (!date.isValid()) {
-        mutex.unlock();
         return availableSlots;
     }
 
@@ -1832,20 +2026,19 @@ QJsonArray PadelDataManager::getAvailableTimeSlots(int courtId, const QDate& dat
         safeMaxAttendees = 2;
     }
 
-    auto courtIt = courtsById.find(courtId);
-    if (courtIt == courtsById.end()) {
-        mutex.unlock();
+    Court court = getCourtById(courtId);
+    CourtShard* shard = shardFor(courtId);
+    if (court.getId() <= 0 || !shard) {
         return availableSlots;
     }
 
-    Court court = courtIt->second;
-    mutex.unlock();
-
     std::vector<QTime> timeSlotsCopy = court.getAllTimeSlots();
     if (timeSlotsCopy.empty()) {
         return availableSlots;
     }
 
+    QReadLocker locker(&shard->lock);
+
     QDateTime currentDateTime = timeLogicInstance.getCurrentTime();
     QDate currentDate = currentDateTime.date();
     QTime currentTime = currentDateTime.time();
@@ -1863,7 +2056,7 @@ QJsonArray PadelDataManager::getAvailableTimeSlots(int courtId, const QDate& dat
         QDateTime startTime(date, time);
         QDateTime endTime = startTime.addSecs(3600);
 
-        int attendees = getCurrentAttendees(courtId, startTime, endTime);
+        int attendees = findOverlappingBookingIds(*shard, startTime, endTime).size();
 
         if (attendees < safeMaxAttendees) {
             QJsonObject slotObj;
@@ -1884,6 +2077,10 @@ QJsonArray PadelDataManager::readCourtsFromFile(QString& errorMessage) const {
     QJsonArray courtsArray;
     QString filePath = dataDir + "/courts.json";
 
+    if (BinarySnapshot::readJsonArrayIfPreferred(filePath, courtsArray)) {
+        return courtsArray;
+    }
+
     QFile file(filePath);
     if (!file.exists()) {
         errorMessage = "Courts file not found at: " + filePath;
@@ -2025,34 +2222,17 @@ Court PadelDataManager::jsonToCourt(const QJsonObject& json) {
     return court;
 }
 
-int PadelDataManager::generateCourtId() const {
-    int maxId = 0;
-
-    for (const auto& pair : courtsById) {
-        if (pair.first > maxId) {
-            maxId = pair.first;
-        }
-    }
-
-    return maxId + 1;
-}
-
-int PadelDataManager::generateBookingId() const {
-    int maxId = 0;
-
-    for (const auto& pair : bookingsById) {
-        if (pair.first > maxId) {
-            maxId = pair.first;
-        }
-    }
-
-    return maxId + 1;
+int PadelDataManager::generateCourtId() {
+    return courtIds.next();
 }
 
-void PadelDataManager::setupTimers() {
-    QTimer* statusTimer = new QTimer(this);
-    connect(statusTimer, &QTimer::timeout, this, &PadelDataManager::checkBookingStatus);
-    statusTimer->start(300000);
+void PadelDataManager::scheduleStatusCheck(const QDateTime& dueTime) {
+    // Waitlists are matched against today's and tomorrow's slots, so the window only
+    // moves when the simulated day changes; cancellations fill slots on their own.
+    SimulationScheduler::instance().scheduleAt(dueTime, this, [this]() {
+        checkBookingStatus();
+        scheduleStatusCheck(SimulationScheduler::nextMidnight());
+    });
 }
 
 bool PadelDataManager::validateBookingTime(const QDateTime& startTime, const QDateTime& endTime,
@@ -2099,17 +2279,19 @@ bool PadelDataManager::validateBookingTime(const QDateTime& startTime, const QDa
 void PadelDataManager::checkBookingStatus() {
     QDateTime now = timeLogicInstance.getCurrentTime();
     QDate today = now.date();
-    QVector<int> processedCourts;
+    QVector<int> courtIds;
+    {
+        QReadLocker locker(&courtsLock);
+        for (const auto& courtEntry : courtsById) {
+            courtIds.append(courtEntry.first);
+        }
+    }
 
-    for (const auto& courtEntry : courtsById) {
-        int courtId = courtEntry.first;
-        
+    for (int courtId : courtIds) {
         if (courtId <= 0) continue;
         
         processWaitlistForDate(courtId, today);
         processWaitlistForDate(courtId, today.addDays(1));
-        
-        processedCourts.append(courtId);
     }
 
     if (dataModified) {
@@ -2143,12 +2325,11 @@ Court PadelDataManager::findClosestAvailableCourt(int originalCourtId, const QDa
         return Court();
     }
 
-    auto originalCourtIt = courtsById.find(originalCourtId);
-    if (originalCourtIt == courtsById.end()) {
+    Court originalCourt = getCourtById(originalCourtId);
+    if (originalCourt.getId() <= 0) {
         return Court();
     }
 
-    const Court& originalCourt = originalCourtIt->second;
     QString originalLocation = originalCourt.getLocation();
 
     QVector<Court> availableCourts = getAvailableCourts(startTime, endTime, originalLocation);
@@ -2172,16 +2353,274 @@ Court PadelDataManager::findClosestAvailableCourt(int originalCourtId, const QDa
     return Court();
 }
 int PadelDataManager::getBookedCourtsCount() const {
-    QMutexLocker locker(&mutex);
-    int bookedCount = 0;
-
     std::set<int> courtsWithBookings;
-    for (const auto& pair : bookingsById) {
-        const Booking& booking = pair.second;
-        if (!booking.isCancelled()) {
-            courtsWithBookings.insert(booking.getCourtId());
+    for (CourtShard* shard : allShards()) {
+        QReadLocker locker(&shard->lock);
+        for (const auto& pair : shard->bookings) {
+            const Booking& booking = pair.second;
+            if (!booking.isCancelled()) {
+                courtsWithBookings.insert(booking.getCourtId());
+            }
         }
     }
 
     return static_cast<int>(courtsWithBookings.size());
-}
\ No newline at end of file
+}
+
+PadelDataManager::BookingTotals PadelDataManager::getBookingTotals() const {
+    BookingTotals totals;
+
+    QReadLocker locker(&courtsLock);
+    totals.totalCourts = static_cast<int>(courtsById.size());
+    for (const auto& shardPair : shards) {
+        int courtBookings = 0;
+        {
+            QReadLocker shardLocker(&shardPair.second->lock);
+            for (const auto& usagePair : shardPair.second->usageByMonth) {
+                courtBookings += usagePair.second.bookings;
+                totals.vipBookings += usagePair.second.vipBookings;
+            }
+        }
+        totals.bookings += courtBookings;
+        totals.bookedCourts += courtBookings > 0;
+    }
+
+    return totals;
+}
+
+QJsonObject PadelDataManager::generateMonthlyReport(const QDate& month) const {
+    QJsonObject report;
+    if (!month.isValid()) {
+        return report;
+    }
+
+    const int monthKey = month.year() * 12 + month.month() - 1;
+    const int daysInMonth = month.daysInMonth();
+
+    int totalBookings = 0;
+    int vipBookings = 0;
+    qint64 bookedMinutes = 0;
+    qint64 capacityMinutes = 0;
+    double totalRevenue = 0.0;
+    QJsonArray courtsArray;
+
+    {
+        QReadLocker locker(&courtsLock);
+        for (const auto& shardPair : shards) {
+            auto courtIt = courtsById.find(shardPair.first);
+            if (courtIt == courtsById.end()) {
+                continue;
+            }
+
+            CourtShard::MonthUsage usage;
+            {
+                QReadLocker shardLocker(&shardPair.second->lock);
+                auto usageIt = shardPair.second->usageByMonth.find(monthKey);
+                if (usageIt != shardPair.second->usageByMonth.end()) {
+                    usage = usageIt->second;
+                }
+            }
+
+            // Every time slot is one hour, available on each day of the month
+            const qint64 courtCapacity =
+                static_cast<qint64>(courtIt->second.getAllTimeSlots().size()) * 60 * daysInMonth;
+
+            QJsonObject courtObj;
+            courtObj["courtId"] = courtIt->first;
+            courtObj["name"] = courtIt->second.getName();
+            courtObj["bookings"] = usage.bookings;
+            courtObj["bookedHours"] = usage.bookedMinutes / 60.0;
+            courtObj["revenue"] = usage.revenue;
+            courtObj["utilization"] = courtCapacity > 0 ? usage.bookedMinutes * 100.0 / courtCapacity : 0.0;
+            courtsArray.append(courtObj);
+
+            totalBookings += usage.bookings;
+            vipBookings += usage.vipBookings;
+            bookedMinutes += usage.bookedMinutes;
+            capacityMinutes += courtCapacity;
+            totalRevenue += usage.revenue;
+        }
+    }
+
+    report["month"] = QDate(month.year(), month.month(), 1).toString(Qt::ISODate);
+    report["totalBookings"] = totalBookings;
+    report["vipBookings"] = vipBookings;
+    report["bookedHours"] = bookedMinutes / 60.0;
+    report["totalRevenue"] = totalRevenue;
+    report["utilization"] = capacityMinutes > 0 ? bookedMinutes * 100.0 / capacityMinutes : 0.0;
+    report["courts"] = courtsArray;
+    return report;
+}
+
+PadelDataManager::CourtShard* PadelDataManager::shardFor(int courtId) const {
+    QReadLocker locker(&courtsLock);
+    auto it = shards.find(courtId);
+    return it != shards.end() ? it->second.get() : nullptr;
+}
+
+PadelDataManager::CourtShard* PadelDataManager::shardForBooking(int bookingId) const {
+    int courtId = 0;
+    {
+        QReadLocker locker(&bookingCourtsLock);
+        auto it = bookingCourts.find(bookingId);
+        if (it == bookingCourts.end()) {
+            return nullptr;
+        }
+        courtId = it->second;
+    }
+
+    return shardFor(courtId);
+}
+
+std::vector<PadelDataManager::CourtShard*> PadelDataManager::allShards() const {
+    QReadLocker locker(&courtsLock);
+
+    std::vector<CourtShard*> result;
+    result.reserve(shards.size());
+    for (const auto& pair : shards) {
+        result.push_back(pair.second.get());
+    }
+    return result;
+}
+
+PadelDataManager::CourtShard& PadelDataManager::ensureShard(int courtId) {
+    std::unique_ptr<CourtShard>& shard = shards[courtId];
+    if (!shard) {
+        shard = std::make_unique<CourtShard>();
+    }
+    return *shard;
+}
+
+void PadelDataManager::storeLoadedBooking(const Booking& booking) {
+    const int bookingId = booking.getBookingId();
+
+    auto courtIt = bookingCourts.find(bookingId);
+    if (courtIt != bookingCourts.end() && courtIt->second != booking.getCourtId()) {
+        eraseLoadedBooking(bookingId);
+    }
+
+    ensureShard(booking.getCourtId()).bookings[bookingId] = booking;
+    bookingCourts[bookingId] = booking.getCourtId();
+    bookingIds.observe(bookingId);
+}
+
+void PadelDataManager::eraseLoadedBooking(int bookingId) {
+    auto courtIt = bookingCourts.find(bookingId);
+    if (courtIt == bookingCourts.end()) {
+        return;
+    }
+
+    auto shardIt = shards.find(courtIt->second);
+    if (shardIt != shards.end()) {
+        shardIt->second->bookings.erase(bookingId);
+    }
+    bookingCourts.erase(courtIt);
+}
+
+void PadelDataManager::clearLoadedBookings() {
+    for (auto& pair : shards) {
+        pair.second->bookings.clear();
+        pair.second->bookingsByDay.clear();
+        pair.second->usageByMonth.clear();
+    }
+    bookingCourts.clear();
+}
+
+int PadelDataManager::reserveBookingId(int courtId) {
+    QWriteLocker locker(&bookingCourtsLock);
+    const int bookingId = bookingIds.next();
+    bookingCourts[bookingId] = courtId;
+    return bookingId;
+}
+
+void PadelDataManager::indexBooking(CourtShard& shard, const Booking& booking) {
+    if (booking.isCancelled() || booking.getStartMinutes() == Booking::InvalidTime) {
+        return;
+    }
+
+    shard.bookingsByDay[booking.getStartTime().date()]
+        .emplace(booking.getStartMinutes(), booking.getBookingId());
+    addMonthUsage(shard, booking, 1);
+}
+
+void PadelDataManager::unindexBooking(CourtShard& shard, const Booking& booking) {
+    auto dayIt = shard.bookingsByDay.find(booking.getStartTime().date());
+    if (dayIt == shard.bookingsByDay.end()) {
+        return;
+    }
+
+    auto range = dayIt->second.equal_range(booking.getStartMinutes());
+    for (auto entryIt = range.first; entryIt != range.second; ++entryIt) {
+        if (entryIt->second == booking.getBookingId()) {
+            dayIt->second.erase(entryIt);
+            addMonthUsage(shard, booking, -1);
+            break;
+        }
+    }
+
+    if (dayIt->second.empty()) {
+        shard.bookingsByDay.erase(dayIt);
+    }
+}
+
+void PadelDataManager::addMonthUsage(CourtShard& shard, const Booking& booking, int sign) {
+    const QDate day = booking.getStartTime().date();
+    const int monthKey = day.year() * 12 + day.month() - 1;
+
+    CourtShard::MonthUsage& usage = shard.usageByMonth[monthKey];
+    usage.bookings += sign;
+    usage.vipBookings += booking.isVip() ? sign : 0;
+    if (booking.getEndMinutes() != Booking::InvalidTime) {
+        usage.bookedMinutes += sign * static_cast<qint64>(booking.getEndMinutes() - booking.getStartMinutes());
+    }
+    usage.revenue += sign * booking.getPrice();
+
+    if (usage.bookings == 0) {
+        shard.usageByMonth.erase(monthKey);
+    }
+}
+
+void PadelDataManager::rebuildBookingIndex(CourtShard& shard) {
+    shard.bookingsByDay.clear();
+    shard.usageByMonth.clear();
+    for (const auto& pair : shard.bookings) {
+        indexBooking(shard, pair.second);
+    }
+}
+
+const std::multimap<qint32, int>* PadelDataManager::bookingsOnDay(const CourtShard& shard, const QDate& date) {
+    auto dayIt = shard.bookingsByDay.find(date);
+    if (dayIt == shard.bookingsByDay.end()) {
+        return nullptr;
+    }
+
+    return &dayIt->second;
+}
+
+QVector<int> PadelDataManager::findOverlappingBookingIds(const CourtShard& shard, const QDateTime& startTime,
+                                                         const QDateTime& endTime) {
+    QVector<int> result;
+
+    if (!startTime.isValid() || !endTime.isValid()) {
+        return result;
+    }
+
+    const qint32 start = Booking::toEpochMinutes(startTime);
+    const qint32 end = Booking::toEpochMinutes(endTime);
+
+    // Start one day early so bookings running past midnight are still seen
+    const auto& days = shard.bookingsByDay;
+    for (auto dayIt = days.lower_bound(startTime.date().addDays(-1));
+         dayIt != days.end() && dayIt->first <= endTime.date(); ++dayIt) {
+        const std::multimap<qint32, int>& dayBookings = dayIt->second;
+        auto last = dayBookings.lower_bound(end);
+
+        for (auto entryIt = dayBookings.begin(); entryIt != last; ++entryIt) {
+            if (shard.bookings.at(entryIt->second).getEndMinutes() > start) {
+                result.append(entryIt->second);
+            }
+        }
+    }
+
+    return result;
+}
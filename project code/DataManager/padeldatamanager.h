@@ -2,21 +2,39 @@
 #define PADELDATAMANAGER_H
 
 #include <unordered_map>
+#include <map>
+#include <memory>
+#include <atomic>
 #include "../Model/Padel/Court.h"
 #include "../Model/Padel/Booking.h"
+#include "../Model/Padel/CourtWaitlist.h"
 #include "../DataManager/memberdatamanager.h"
+#include "../DataManager/idallocator.h"
 #include <QString>
 #include <QVector>
 #include <QTimer>
-#include <queue>
-
-// Structure to store waitlist entries
-struct WaitlistEntry {
-    int memberId;
-    int courtId;
-    QDateTime requestedTime;
-    bool isVIP;
-    int priority;
+#include <QFile>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QHash>
+#include <QSet>
+
+// Structure for one cell of the weekly booking calendar
+struct SlotOccupancy {
+    int attendees = 0;
+    bool isBookedByUser = false;
+    int userBookingId = -1;
+};
+
+// Structure for the occupancy of one court over a week of hourly slots
+struct WeekOccupancy {
+    QDate weekStart;
+    QTime firstSlot;
+    int slotsPerDay = 0;
+    int maxAttendees = 0;
+    QVector<SlotOccupancy> cells; // Row-major: cells[day * slotsPerDay + slot]
+
+    const SlotOccupancy& at(int day, int slot) const { return cells[day * slotsPerDay + slot]; }
 };
 
 class PadelDataManager : public QObject {
@@ -66,6 +84,8 @@ public:
     QVector<Booking> getUserAutoBookings(int userId) const;
     bool isCourtAvailable(int courtId, const QDateTime& startTime, 
                          const QDateTime& endTime) const;
+    WeekOccupancy getWeekOccupancy(int courtId, const QDate& weekStart, int userId,
+                                   const QTime& firstSlot, int slotsPerDay) const;
 
     // VIP management
     double calculateBookingPrice(int courtId, const QDateTime& startTime,
@@ -97,6 +117,14 @@ public:
     QJsonArray getAllTimeSlotsJson(int courtId) const;
 
     // Reporting
+    struct BookingTotals {
+        int totalCourts = 0;
+        int bookedCourts = 0;   // Courts with at least one active booking
+        int bookings = 0;       // Active bookings over all months
+        int vipBookings = 0;
+    };
+    // Summed from the per-court monthly usage, without walking the bookings
+    BookingTotals getBookingTotals() const;
     QJsonObject generateMonthlyReport(const QDate& month) const;
     QJsonObject generateCourtUtilizationReport(int courtId, const QDate& startDate, 
                                              const QDate& endDate) const;
@@ -116,7 +144,9 @@ signals:
     void bookingCancelled(int bookingId, int userId);
     void bookingRescheduled(int bookingId, int userId);
     void waitlistUpdated(int courtId);
-    void waitlistPositionChanged(int userId, int courtId, int position);
+    // Users of one court whose waitlist position changed, as userId -> position (-1 when removed).
+    // Emitted at most once per court per event-loop iteration.
+    void waitlistPositionsChanged(int courtId, const QHash<int, int>& positions);
     void vipStatusChanged(int memberId, bool isVIP);
     void courtAvailabilityChanged(int courtId);
     void waitlistBookingCreated(int userId, int courtId, const QDateTime& startTime);
@@ -124,43 +154,126 @@ signals:
 private slots:
     void safeEmitBookingCreated(int bookingId, int userId);
     void safeEmitBookingCancelled(int bookingId, int userId);
+    void onPersistenceBarrier(quint64 ticket);
+    void flushWaitlistPositionUpdates();
 
 private:
+    // Everything that belongs to one court: its bookings, their day index and its waitlist.
+    // Each shard has its own lock, so work on different courts never contends.
+    struct CourtShard {
+        mutable QReadWriteLock lock;
+        std::unordered_map<int, Booking> bookings;
+        // Active bookings per day, ordered by start time (epoch minutes) -> booking id
+        std::map<QDate, std::multimap<qint32, int>> bookingsByDay;
+        // Active bookings per month of their start (year * 12 + month - 1), kept
+        // alongside bookingsByDay so monthly reports are a lookup
+        struct MonthUsage {
+            int bookings = 0;
+            int vipBookings = 0;
+            qint64 bookedMinutes = 0;
+            double revenue = 0.0;
+        };
+        std::map<int, MonthUsage> usageByMonth;
+        CourtWaitlist waitlist;
+    };
+
+    // Lock order: courtsLock, then shard locks (one at a time, or all of them in court id
+    // order for snapshots), then bookingCourtsLock, journalMutex and notificationMutex.
+    // Signals are emitted after the locks are released.
     QString dataDir;
-    mutable QMutex mutex;
+    mutable QReadWriteLock courtsLock;                       // Court catalogue, shard map and VIP flags
     std::unordered_map<int, Court> courtsById;
-    std::unordered_map<int, Booking> bookingsById;
-    std::unordered_map<int, std::queue<WaitlistEntry>> courtWaitlists;
+    IdAllocator courtIds{"courts"};
+    std::map<int, std::unique_ptr<CourtShard>> shards;       // Shards are never removed while running
     std::unordered_map<int, bool> vipMembers;
-    bool dataModified = false;
+    mutable QReadWriteLock bookingCourtsLock;
+    std::unordered_map<int, int> bookingCourts;              // Booking id -> court id
+    IdAllocator bookingIds{"bookings"};
+    // Last positions announced per court (userId -> position) and courts awaiting a flush
+    QMutex notificationMutex;
+    QHash<int, QHash<int, int>> notifiedWaitlistPositions;
+    QSet<int> pendingPositionCourts;
+    std::atomic<bool> dataModified{false};
     MemberDataManager* memberDataManager;
 
+    // Append-only mutation journal, folded into the JSON snapshots by saveToFile().
+    // On compaction the live journal is parked in compactingJournalPath until the
+    // background writes of the snapshots have completed.
+    static constexpr int JournalCompactionThreshold = 1000;
+    QMutex journalMutex;
+    QFile journalFile;
+    QString compactingJournalPath;
+    int journalEntryCount = 0;
+    quint64 compactionTicket = 0;
+    bool snapshotWriteFailed = false;
+
     // File operations
     QJsonArray readCourtsFromFile(QString& errorMessage) const;
     QJsonArray readBookingsFromFile(QString& errorMessage) const;
     QJsonArray readWaitlistsFromFile(QString& errorMessage) const;
-    bool writeBookingsToFile(const QJsonArray& bookings, QString& errorMessage) const;
-    bool writeCourtsToFile(const QJsonArray& courts, QString& errorMessage) const;
-    bool writeWaitlistsToFile(const QJsonArray& waitlists, QString& errorMessage) const;
-    QJsonArray waitlistsToJson() const;
+    // Records are copied under the locks; their JSON is built on the persistence thread
+    bool writeBookingsToFile(std::shared_ptr<const std::vector<Booking>> bookings, QString& errorMessage) const;
+    bool writeCourtsToFile(std::vector<Court> courts, QString& errorMessage) const;
+    bool writeWaitlistsToFile(std::vector<WaitlistEntry> waitlists, QString& errorMessage) const;
+
+    // Typed binary snapshot of the bookings (bookings.bin), see BinarySnapshot
+    static constexpr quint32 BookingSnapshotSchema = 0x424F4F4B; // "BOOK"
+    static constexpr quint16 BookingSnapshotVersion = 1;
+    bool readBookingsSnapshot(QString& errorMessage);
+    void writeBookingsSnapshot(std::shared_ptr<const std::vector<Booking>> bookings) const;
+    static bool decodeBookingRecord(const uchar* record, quint32 size, Booking& booking);
+    static bool bookingRecordToJson(const uchar* record, quint32 size, QJsonObject& object);
+    static const bool bookingSnapshotRegistered;   // Lets the snapshot converter read bookings.bin
+
+    // Journal operations
+    bool appendToJournal(const QJsonObject& entry);
+    void journalBooking(const Booking& booking);
+    void journalBookingDeleted(int bookingId);
+    void journalWaitlist(int courtId, const CourtWaitlist& waitlist);
+    bool replayJournal(QString& errorMessage);
+    bool replayJournalFile(QFile& file, QString& errorMessage);
+    bool rotateJournal();
     
     // JSON conversion
-    QJsonObject courtToJson(const Court& court) const;
-    QJsonObject bookingToJson(const Booking& booking) const;
+    static QJsonObject courtToJson(const Court& court);
+    static QJsonObject bookingToJson(const Booking& booking);
     static Court jsonToCourt(const QJsonObject& json);
     static Booking jsonToBooking(const QJsonObject& json);
+    static QJsonObject waitlistEntryToJson(const WaitlistEntry& entry);
+    static WaitlistEntry jsonToWaitlistEntry(const QJsonObject& json);
     
     // Helper methods
-    [[nodiscard]] int generateCourtId() const;
-    [[nodiscard]] int generateBookingId() const;
-    void setupTimers();
+    int generateCourtId();
+    int reserveBookingId(int courtId);
+    void scheduleStatusCheck(const QDateTime& dueTime);
     bool validateBookingTime(const QDateTime& startTime, const QDateTime& endTime, 
                            QString& errorMessage) const;
     bool validateCourtAvailability(int courtId, const QDateTime& startTime, 
                                  const QDateTime& endTime) const;
     void updateWaitlistPositionsAndNotify(int courtId);
     void removeUserFromAllWaitlists(int userId, int courtId, const QDate& date);
-    int countDailyBookings(int courtId, const QDate& date) const;
+    WaitlistEntry makeWaitlistEntry(int userId, int courtId, const QDateTime& requestedTime) const;
+    void enqueueWaitlistEntry(CourtShard& shard, const WaitlistEntry& entry);
+
+    // Shard lookup (takes courtsLock / bookingCourtsLock briefly)
+    CourtShard* shardFor(int courtId) const;
+    CourtShard* shardForBooking(int bookingId) const;
+    std::vector<CourtShard*> allShards() const;
+
+    // Loading (single-threaded, caller holds courtsLock for writing)
+    CourtShard& ensureShard(int courtId);
+    void storeLoadedBooking(const Booking& booking);
+    void eraseLoadedBooking(int bookingId);
+    void clearLoadedBookings();
+
+    // Booking index maintenance (caller holds the shard lock)
+    static void indexBooking(CourtShard& shard, const Booking& booking);
+    static void unindexBooking(CourtShard& shard, const Booking& booking);
+    static void rebuildBookingIndex(CourtShard& shard);
+    static void addMonthUsage(CourtShard& shard, const Booking& booking, int sign);
+    static const std::multimap<qint32, int>* bookingsOnDay(const CourtShard& shard, const QDate& date);
+    static QVector<int> findOverlappingBookingIds(const CourtShard& shard, const QDateTime& startTime,
+                                                  const QDateTime& endTime);
 };
 
 #endif // PADELDATAMANAGER_H 
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include "passwordhasher.h"
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMessageAuthenticationCode>
+#include <QRandomGenerator>
+#include <QSettings>
+#include <QStringList>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const QString HashPrefix = QStringLiteral("$scrypt$");
+
+constexpr QByteArray::Base64Options Base64Encoding =
+    QByteArray::Base64Encoding | QByteArray::OmitTrailingEquals;
+
+// PBKDF2-HMAC-SHA256 with a single iteration, as scrypt uses it
+QByteArray pbkdf2Sha256(const QByteArray& password, const QByteArray& salt, int length) {
+    QByteArray output;
+    output.reserve(length);
+    for (quint32 block = 1; output.size() < length; ++block) {
+        QByteArray message = salt;
+        quint32 blockIndex = qToBigEndian(block);
+        message.append(reinterpret_cast<const char*>(&blockIndex), sizeof(blockIndex));
+        output.append(QMessageAuthenticationCode::hash(message, password, QCryptographicHash::Sha256));
+    }
+    output.truncate(length);
+    return output;
+}
+
+inline quint32 rotl(quint32 value, int shift) {
+    return (value << shift) | (value >> (32 - shift));
+}
+
+// Salsa20/8 core on one 64-byte block, in place
+void salsa208(quint32 block[16]) {
+    quint32 x[16];
+    std::memcpy(x, block, sizeof(x));
+    for (int round = 0; round < 8; round += 2) {
+        x[4] ^= rotl(x[0] + x[12], 7);   x[8] ^= rotl(x[4] + x[0], 9);
+        x[12] ^= rotl(x[8] + x[4], 13);  x[0] ^= rotl(x[12] + x[8], 18);
+        x[9] ^= rotl(x[5] + x[1], 7);    x[13] ^= rotl(x[9] + x[5], 9);
+        x[1] ^= rotl(x[13] + x[9], 13);  x[5] ^= rotl(x[1] + x[13], 18);
+        x[14] ^= rotl(x[10] + x[6], 7);  x[2] ^= rotl(x[14] + x[10], 9);
+        x[6] ^= rotl(x[2] + x[14], 13);  x[10] ^= rotl(x[6] + x[2], 18);
+        x[3] ^= rotl(x[15] + x[11], 7);  x[7] ^= rotl(x[3] + x[15], 9);
+        x[11] ^= rotl(x[7] + x[3], 13);  x[15] ^= rotl(x[11] + x[7], 18);
+        x[1] ^= rotl(x[0] + x[3], 7);    x[2] ^= rotl(x[1] + x[0], 9);
+        x[3] ^= rotl(x[2] + x[1], 13);   x[0] ^= rotl(x[3] + x[2], 18);
+        x[6] ^= rotl(x[5] + x[4], 7);    x[7] ^= rotl(x[6] + x[5], 9);
+        x[4] ^= rotl(x[7] + x[6], 13);   x[5] ^= rotl(x[4] + x[7], 18);
+        x[11] ^= rotl(x[10] + x[9], 7);  x[8] ^= rotl(x[11] + x[10], 9);
+        x[9] ^= rotl(x[8] + x[11], 13);  x[10] ^= rotl(x[9] + x[8], 18);
+        x[12] ^= rotl(x[15] + x[14], 7); x[13] ^= rotl(x[12] + x[15], 9);
+        x[14] ^= rotl(x[13] + x[12], 13); x[15] ^= rotl(x[14] + x[13], 18);
+    }
+    for (int i = 0; i < 16; ++i) {
+        block[i] += x[i];
+    }
+}
+
+// scryptBlockMix: input and output are 2 * r blocks of 16 words
+void blockMix(const quint32* input, quint32* output, int blockSize) {
+    quint32 x[16];
+    std::memcpy(x, input + (2 * blockSize - 1) * 16, sizeof(x));
+    for (int i = 0; i < 2 * blockSize; ++i) {
+        for (int k = 0; k < 16; ++k) {
+            x[k] ^= input[i * 16 + k];
+        }
+        salsa208(x);
+        // Even blocks go to the first half of the output, odd blocks to the second
+        const int target = (i / 2) + (i % 2) * blockSize;
+        std::memcpy(output + target * 16, x, sizeof(x));
+    }
+}
+
+// scryptROMix over one 128 * r byte chunk, in place; V is the memory-hard table
+void roMix(quint8* chunk, int blockSize, quint64 n) {
+    const size_t words = 32 * static_cast<size_t>(blockSize);
+    std::vector<quint32> x(words);
+    std::vector<quint32> y(words);
+    std::vector<quint32> v(words * n);
+
+    for (size_t k = 0; k < words; ++k) {
+        x[k] = qFromLittleEndian<quint32>(chunk + 4 * k);
+    }
+
+    for (quint64 i = 0; i < n; ++i) {
+        std::copy(x.begin(), x.end(), v.begin() + i * words);
+        blockMix(x.data(), y.data(), blockSize);
+        x.swap(y);
+    }
+
+    for (quint64 i = 0; i < n; ++i) {
+        const quint64 j = x[(2 * blockSize - 1) * 16] & (n - 1);
+        const quint32* row = v.data() + j * words;
+        for (size_t k = 0; k < words; ++k) {
+            x[k] ^= row[k];
+        }
+        blockMix(x.data(), y.data(), blockSize);
+        x.swap(y);
+    }
+
+    for (size_t k = 0; k < words; ++k) {
+        qToLittleEndian<quint32>(x[k], chunk + 4 * k);
+    }
+}
+
+} // namespace
+
+int PasswordHasher::configuredCost() {
+    static const int cost = std::clamp(QSettings().value("security/passwordCost", DefaultCost).toInt(),
+                                       MinCost, MaxCost);
+    return cost;
+}
+
+QByteArray PasswordHasher::scrypt(const QByteArray& password, const QByteArray& salt,
+                                  int cost, int blockSize, int parallelism, int length) {
+    const quint64 n = quint64(1) << cost;
+    const int chunkSize = 128 * blockSize;
+
+    QByteArray blocks = pbkdf2Sha256(password, salt, parallelism * chunkSize);
+    for (int i = 0; i < parallelism; ++i) {
+        roMix(reinterpret_cast<quint8*>(blocks.data()) + i * chunkSize, blockSize, n);
+    }
+    return pbkdf2Sha256(password, blocks, length);
+}
+
+QString PasswordHasher::hash(const QString& password, int cost) {
+    cost = std::clamp(cost, MinCost, MaxCost);
+
+    QByteArray salt(SaltLength, Qt::Uninitialized);
+    QRandomGenerator::system()->fillRange(reinterpret_cast<quint32*>(salt.data()), SaltLength / 4);
+
+    const QByteArray derived = scrypt(password.toUtf8(), salt, cost, BlockSize, Parallelism, HashLength);
+    return HashPrefix + QString("ln=%1,r=%2,p=%3$%4$%5")
+        .arg(cost)
+        .arg(BlockSize)
+        .arg(Parallelism)
+        .arg(QString::fromLatin1(salt.toBase64(Base64Encoding)))
+        .arg(QString::fromLatin1(derived.toBase64(Base64Encoding)));
+}
+
+bool PasswordHasher::parse(const QString& stored, Parsed& parsed) {
+    if (!stored.startsWith(HashPrefix)) {
+        return false;
+    }
+
+    const QStringList fields = stored.mid(HashPrefix.size()).split('$');
+    if (fields.size() != 3) {
+        return false;
+    }
+
+    for (const QString& parameter : fields[0].split(',')) {
+        bool ok = false;
+        const int value = parameter.section('=', 1).toInt(&ok);
+        if (!ok) {
+            return false;
+        }
+        const QString name = parameter.section('=', 0, 0);
+        if (name == "ln") parsed.cost = value;
+        else if (name == "r") parsed.blockSize = value;
+        else if (name == "p") parsed.parallelism = value;
+        else return false;
+    }
+
+    const auto salt = QByteArray::fromBase64Encoding(fields[1].toLatin1(), Base64Encoding | QByteArray::AbortOnBase64DecodingErrors);
+    const auto hash = QByteArray::fromBase64Encoding(fields[2].toLatin1(), Base64Encoding | QByteArray::AbortOnBase64DecodingErrors);
+    if (!salt || !hash) {
+        return false;
+    }
+    parsed.salt = *salt;
+    parsed.hash = *hash;
+
+    // Bounded before anything is allocated: the stored string decides the memory a verify takes
+    return parsed.cost >= MinCost && parsed.cost <= MaxCost &&
+           parsed.blockSize == BlockSize && parsed.parallelism == Parallelism &&
+           memoryFor(parsed.cost, parsed.blockSize) <= MaxMemory &&
+           !parsed.salt.isEmpty() && parsed.hash.size() == HashLength;
+}
+
+bool PasswordHasher::isHash(const QString& stored) {
+    Parsed parsed;
+    return parse(stored, parsed);
+}
+
+PasswordHasher::Verification PasswordHasher::verify(const QString& password, const QString& stored) {
+    Verification result;
+
+    Parsed parsed;
+    if (!parse(stored, parsed)) {
+        // Legacy plain text: compare digests so the comparison does not depend on length either
+        const QByteArray given = QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256);
+        const QByteArray expected = QCryptographicHash::hash(stored.toUtf8(), QCryptographicHash::Sha256);
+        result.valid = !stored.isEmpty() && constantTimeEquals(given, expected);
+        result.needsRehash = result.valid;
+        return result;
+    }
+
+    const QByteArray derived = scrypt(password.toUtf8(), parsed.salt, parsed.cost,
+                                      parsed.blockSize, parsed.parallelism, parsed.hash.size());
+    result.valid = constantTimeEquals(derived, parsed.hash);
+    result.needsRehash = result.valid && parsed.cost != configuredCost();
+    return result;
+}
+
+bool PasswordHasher::constantTimeEquals(const QByteArray& a, const QByteArray& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    quint8 difference = 0;
+    for (qsizetype i = 0; i < a.size(); ++i) {
+        difference |= static_cast<quint8>(a[i]) ^ static_cast<quint8>(b[i]);
+    }
+    return difference == 0;
+}
+
+void PasswordHasher::runBenchmark(int minCost, int maxCost, int rounds) {
+    minCost = std::clamp(minCost, MinCost, MaxCost);
+    maxCost = std::clamp(maxCost, minCost, MaxCost);
+    rounds = std::max(1, rounds);
+
+    const QString password = QStringLiteral("correct horse battery staple");
+    qInfo().noquote() << QString("scrypt r=%1 p=%2, %3 verifications per cost (configured cost: %4)")
+                             .arg(BlockSize).arg(Parallelism).arg(rounds).arg(configuredCost());
+    qInfo().noquote() << "cost  memory     median ms   min ms   max ms";
+
+    for (int cost = minCost; cost <= maxCost; ++cost) {
+        const QString stored = hash(password, cost);
+
+        std::vector<double> timings;
+        timings.reserve(rounds);
+        for (int round = 0; round < rounds; ++round) {
+            QElapsedTimer timer;
+            timer.start();
+            const Verification verification = verify(password, stored);
+            timings.push_back(timer.nsecsElapsed() / 1e6);
+            if (!verification.valid) {
+                qWarning() << "Benchmark hash failed to verify at cost" << cost;
+                return;
+            }
+        }
+
+        std::sort(timings.begin(), timings.end());
+        const double memoryMiB = memoryFor(cost, BlockSize) / (1024.0 * 1024.0);
+        qInfo().noquote() << QString("%1    %2 MiB  %3  %4  %5")
+                                 .arg(cost, 2)
+                                 .arg(memoryMiB, 6, 'f', 1)
+                                 .arg(timings[timings.size() / 2], 10, 'f', 1)
+                                 .arg(timings.front(), 7, 'f', 1)
+                                 .arg(timings.back(), 7, 'f', 1);
+    }
+}
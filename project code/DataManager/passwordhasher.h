@@ -0,0 +1,61 @@
+#ifndef PASSWORDHASHER_H
+#define PASSWORDHASHER_H
+
+#include <QByteArray>
+#include <QString>
+
+// Salted, memory-hard password hashes (scrypt, RFC 7914) in a self-describing form:
+//
+//   $scrypt$ln=<log2 N>,r=<block size>,p=<parallelism>$<base64 salt>$<base64 hash>
+//
+// The cost (log2 N) is read from the "security/passwordCost" setting; every step up
+// doubles both time and memory (128 * r * N bytes, 16 MiB at the default). Hashes made
+// with another cost still verify and are reported as needing a rehash. Only r and p as
+// written here and costs in [MinCost, MaxCost] are accepted, so no stored value can make
+// a verification use more than MaxMemory. Stored values that are not in this form are
+// legacy plain-text passwords, compared in constant time so they can be upgraded on the
+// next successful login.
+class PasswordHasher {
+public:
+    static constexpr int DefaultCost = 14;
+    static constexpr int MinCost = 10;
+    static constexpr int MaxCost = 18;
+    static constexpr int BlockSize = 8;
+    static constexpr int Parallelism = 1;
+    static constexpr qint64 MaxMemory = qint64(256) * 1024 * 1024;
+    static constexpr int SaltLength = 16;
+    static constexpr int HashLength = 32;
+
+    struct Verification {
+        bool valid = false;
+        bool needsRehash = false;   // Legacy plain text, or hashed with another cost
+    };
+
+    static int configuredCost();
+
+    static QString hash(const QString& password, int cost = configuredCost());
+    static Verification verify(const QString& password, const QString& stored);
+    static bool isHash(const QString& stored);
+
+    // Compares every byte regardless of where the first difference is
+    static bool constantTimeEquals(const QByteArray& a, const QByteArray& b);
+
+    static QByteArray scrypt(const QByteArray& password, const QByteArray& salt,
+                             int cost, int blockSize, int parallelism, int length);
+
+    // Median verify latency in milliseconds for each cost in [minCost, maxCost]
+    static void runBenchmark(int minCost, int maxCost, int rounds);
+
+private:
+    struct Parsed {
+        int cost = 0;
+        int blockSize = 0;
+        int parallelism = 0;
+        QByteArray salt;
+        QByteArray hash;
+    };
+    static bool parse(const QString& stored, Parsed& parsed);
+    static qint64 memoryFor(int cost, int blockSize) { return qint64(128) * blockSize << cost; }
+};
+
+#endif // PASSWORDHASHER_H
@@ -0,0 +1,143 @@
+#include "persistenceservice.h"
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QMutexLocker>
+#include <QDebug>
+
+PersistenceService& PersistenceService::instance() {
+    static PersistenceService service;
+    return service;
+}
+
+PersistenceService::PersistenceService() {
+    start(QThread::LowPriority);
+}
+
+PersistenceService::~PersistenceService() {
+    {
+        QMutexLocker locker(&mutex);
+        running = false;
+    }
+    jobAvailable.wakeAll();
+    wait(); // Remaining jobs are drained before the thread exits
+}
+
+void PersistenceService::scheduleWrite(const QString& filePath, const QJsonDocument& document) {
+    scheduleWrite(filePath, [document]() { return document.toJson(QJsonDocument::Indented); });
+}
+
+void PersistenceService::scheduleWrite(const QString& filePath, std::function<QByteArray()> serializer) {
+    {
+        QMutexLocker locker(&mutex);
+
+        // Coalesce with a queued (not yet started) write for the same file
+        for (Job& job : jobs) {
+            if (job.filePath == filePath) {
+                job.serializer = std::move(serializer);
+                return;
+            }
+        }
+
+        Job job;
+        job.filePath = filePath;
+        job.serializer = std::move(serializer);
+        jobs.push_back(std::move(job));
+    }
+    jobAvailable.wakeOne();
+}
+
+quint64 PersistenceService::scheduleBarrier() {
+    quint64 ticket;
+    {
+        QMutexLocker locker(&mutex);
+        Job job;
+        job.ticket = nextTicket++;
+        ticket = job.ticket;
+        jobs.push_back(job);
+    }
+    jobAvailable.wakeOne();
+    return ticket;
+}
+
+bool PersistenceService::flush() {
+    QMutexLocker locker(&mutex);
+    while (!jobs.empty() || busy) {
+        queueDrained.wait(&mutex);
+    }
+
+    bool success = !writeFailed;
+    writeFailed = false;
+    return success;
+}
+
+void PersistenceService::run() {
+    while (true) {
+        Job job;
+        {
+            QMutexLocker locker(&mutex);
+            while (jobs.empty() && running) {
+                jobAvailable.wait(&mutex);
+            }
+            if (jobs.empty()) {
+                break;
+            }
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            busy = true;
+        }
+
+        if (job.filePath.isEmpty()) {
+            emit barrierReached(job.ticket);
+        } else {
+            QString errorMessage;
+            bool success = writeAtomically(job.filePath, job.serializer(), errorMessage);
+            if (!success) {
+                qDebug() << "Background save failed for" << job.filePath << ":" << errorMessage;
+            }
+            emit writeFinished(job.filePath, success, errorMessage);
+
+            if (!success) {
+                QMutexLocker locker(&mutex);
+                writeFailed = true;
+            }
+        }
+
+        {
+            QMutexLocker locker(&mutex);
+            busy = false;
+            if (jobs.empty()) {
+                queueDrained.wakeAll();
+            }
+        }
+    }
+
+    QMutexLocker locker(&mutex);
+    queueDrained.wakeAll();
+}
+
+bool PersistenceService::writeAtomically(const QString& filePath, const QByteArray& data, QString& errorMessage) {
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    // QSaveFile writes to a temporary file and renames it over the target on commit()
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        errorMessage = "Could not open file for writing: " + file.errorString();
+        return false;
+    }
+
+    if (file.write(data) != data.size()) {
+        errorMessage = "Failed to write file: " + file.errorString();
+        file.cancelWriting();
+        file.commit();
+        return false;
+    }
+
+    if (!file.commit()) {
+        errorMessage = "Failed to commit file: " + file.errorString();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,61 @@
+#ifndef PERSISTENCESERVICE_H
+#define PERSISTENCESERVICE_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QJsonDocument>
+#include <QString>
+#include <deque>
+#include <functional>
+
+// Background writer shared by all data managers. Managers hand over an immutable
+// snapshot (a QJsonDocument or a serializer owning its data); serialisation and the
+// atomic file replace happen on this thread. A newer snapshot for a path that is
+// still queued replaces the older one.
+class PersistenceService : public QThread {
+    Q_OBJECT
+
+public:
+    static PersistenceService& instance();
+
+    void scheduleWrite(const QString& filePath, const QJsonDocument& document);
+    // The serializer runs on the persistence thread and must only touch data it owns
+    void scheduleWrite(const QString& filePath, std::function<QByteArray()> serializer);
+    // Returns a ticket that is signalled once every write queued before it is on disk
+    quint64 scheduleBarrier();
+    // Blocks until the queue is drained; returns false if any write failed since the last flush
+    bool flush();
+
+signals:
+    void writeFinished(const QString& filePath, bool success, const QString& errorMessage);
+    void barrierReached(quint64 ticket);
+
+protected:
+    void run() override;
+
+private:
+    PersistenceService();
+    ~PersistenceService() override;
+    PersistenceService(const PersistenceService&) = delete;
+    PersistenceService& operator=(const PersistenceService&) = delete;
+
+    struct Job {
+        QString filePath;        // Empty for barriers
+        std::function<QByteArray()> serializer;
+        quint64 ticket = 0;
+    };
+
+    static bool writeAtomically(const QString& filePath, const QByteArray& data, QString& errorMessage);
+
+    QMutex mutex;
+    QWaitCondition jobAvailable;
+    QWaitCondition queueDrained;
+    std::deque<Job> jobs;
+    quint64 nextTicket = 1;
+    bool busy = false;
+    bool running = true;
+    bool writeFailed = false;
+};
+
+#endif // PERSISTENCESERVICE_H
@@ -0,0 +1,117 @@
+#include "textsearchindex.h"
+#include <algorithm>
+#include <iterator>
+
+TextSearchIndex::Gram TextSearchIndex::makeGram(const QChar* chars, int length) {
+    // Length in the top bits keeps "a" and "a\0\0"-style prefixes apart
+    Gram gram = static_cast<Gram>(length) << 48;
+    for (int i = 0; i < length; ++i) {
+        gram |= static_cast<Gram>(chars[i].unicode()) << (16 * (MaxGramLength - 1 - i));
+    }
+    return gram;
+}
+
+std::vector<TextSearchIndex::Gram> TextSearchIndex::gramsOfLength(const QString& foldedText, int n) {
+    std::vector<Gram> grams;
+    for (int i = 0; i + n <= foldedText.size(); ++i) {
+        grams.push_back(makeGram(foldedText.constData() + i, n));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+std::vector<TextSearchIndex::Gram> TextSearchIndex::gramsOf(const QString& foldedText) {
+    std::vector<Gram> grams;
+    for (int n = 1; n <= MaxGramLength; ++n) {
+        std::vector<Gram> ofLength = gramsOfLength(foldedText, n);
+        grams.insert(grams.end(), ofLength.begin(), ofLength.end());
+    }
+    return grams;
+}
+
+void TextSearchIndex::insert(int id, const QString& text) {
+    remove(id);
+
+    const QString folded = text.toCaseFolded();
+    for (Gram gram : gramsOf(folded)) {
+        std::vector<int>& ids = postings[gram];
+        // Ids mostly arrive in increasing order, so this is usually an append
+        ids.insert(std::lower_bound(ids.begin(), ids.end(), id), id);
+    }
+    texts.emplace(id, folded);
+}
+
+void TextSearchIndex::remove(int id) {
+    auto textIt = texts.find(id);
+    if (textIt == texts.end()) {
+        return;
+    }
+
+    for (Gram gram : gramsOf(textIt->second)) {
+        auto postingIt = postings.find(gram);
+        if (postingIt == postings.end()) {
+            continue;
+        }
+
+        std::vector<int>& ids = postingIt->second;
+        auto idIt = std::lower_bound(ids.begin(), ids.end(), id);
+        if (idIt != ids.end() && *idIt == id) {
+            ids.erase(idIt);
+        }
+        if (ids.empty()) {
+            postings.erase(postingIt);
+        }
+    }
+    texts.erase(textIt);
+}
+
+void TextSearchIndex::clear() {
+    texts.clear();
+    postings.clear();
+}
+
+std::vector<int> TextSearchIndex::search(const QString& query) const {
+    const QString folded = query.toCaseFolded();
+
+    if (folded.isEmpty()) {
+        std::vector<int> all;
+        all.reserve(texts.size());
+        for (const auto& pair : texts) {
+            all.push_back(pair.first);
+        }
+        std::sort(all.begin(), all.end());
+        return all;
+    }
+
+    const int n = std::min<int>(folded.size(), MaxGramLength);
+    std::vector<const std::vector<int>*> lists;
+    for (Gram gram : gramsOfLength(folded, n)) {
+        auto postingIt = postings.find(gram);
+        if (postingIt == postings.end()) {
+            return {};
+        }
+        lists.push_back(&postingIt->second);
+    }
+
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<int>* a, const std::vector<int>* b) { return a->size() < b->size(); });
+
+    std::vector<int> candidates = *lists.front();
+    std::vector<int> narrowed;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+        narrowed.clear();
+        std::set_intersection(candidates.begin(), candidates.end(),
+                              lists[i]->begin(), lists[i]->end(), std::back_inserter(narrowed));
+        candidates.swap(narrowed);
+    }
+
+    // Grams only show the pieces are present; queries longer than a gram still need the whole match
+    if (folded.size() > MaxGramLength) {
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [this, &folded](int id) {
+            return !texts.at(id).contains(folded);
+        }), candidates.end());
+    }
+
+    return candidates;
+}
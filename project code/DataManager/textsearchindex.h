@@ -0,0 +1,41 @@
+#ifndef TEXTSEARCHINDEX_H
+#define TEXTSEARCHINDEX_H
+
+#include <QString>
+#include <unordered_map>
+#include <vector>
+
+// Case-insensitive substring search over short texts (names, emails) keyed by id.
+//
+// Every case-folded 1-, 2- and 3-gram of a text maps to a sorted posting list of ids.
+// A query looks up the posting lists of its own grams (3-grams, or the whole query when
+// it is shorter), intersects them starting from the shortest and confirms the
+// candidates against the stored text. Only ids sharing every gram are touched, so the
+// cost follows the number of plausible matches rather than the number of entries.
+class TextSearchIndex {
+public:
+    // Indexes text under id, replacing whatever id had before
+    void insert(int id, const QString& text);
+    void remove(int id);
+    void clear();
+
+    // Ids whose text contains query (case-insensitively), in ascending order.
+    // An empty query matches everything.
+    std::vector<int> search(const QString& query) const;
+
+    size_t size() const { return texts.size(); }
+
+private:
+    using Gram = quint64;
+    static constexpr int MaxGramLength = 3;
+
+    static Gram makeGram(const QChar* chars, int length);
+    static std::vector<Gram> gramsOf(const QString& foldedText);
+    // Distinct grams of exactly length n (n <= MaxGramLength) in foldedText
+    static std::vector<Gram> gramsOfLength(const QString& foldedText, int n);
+
+    std::unordered_map<int, QString> texts;                // id -> case-folded text
+    std::unordered_map<Gram, std::vector<int>> postings;   // gram -> sorted ids
+};
+
+#endif // TEXTSEARCHINDEX_H
@@ -10,6 +10,12 @@
 #include <QDebug>
 #include <QCoreApplication>
 #include <QFileInfo>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrent>
+#include "persistenceservice.h"
+#include "binarysnapshot.h"
+#include "passwordhasher.h"
 
 UserDataManager::UserDataManager(QObject* parent)
     : QObject(parent)
@@ -30,6 +36,7 @@ UserDataManager::UserDataManager(QObject* parent)
 
     // Set data directory paths
     dataDir = projectDir + "/project code/Data";
+    userIds.load(dataDir + "/id_allocators.json");
     usersPhotoDir = projectDir + "/project code/UsersPhoto";
 
     qDebug() << "Data directory path:" << dataDir;
@@ -59,6 +66,14 @@ UserDataManager::UserDataManager(QObject* parent)
     if (!initializeFromFile()) {
         qDebug() << "Failed to initialize user data from file";
     }
+
+    // Keep the data dirty if a background save of users.json fails
+    connect(&PersistenceService::instance(), &PersistenceService::writeFinished, this,
+            [this](const QString& filePath, bool success) {
+                if (!success && filePath == QDir(dataDir).filePath("users.json")) {
+                    dataModified = true;
+                }
+            });
 }
 
 UserDataManager::~UserDataManager()
@@ -78,6 +93,10 @@ void UserDataManager::handleApplicationClosing()
     } else {
         qDebug() << "No changes to user data, skipping save on application exit";
     }
+
+    if (!PersistenceService::instance().flush()) {
+        qDebug() << "Some background saves failed before application closing!";
+    }
 }
 
 bool UserDataManager::initializeFromFile()
@@ -91,11 +110,14 @@ bool UserDataManager::initializeFromFile()
 
     usersById.clear();
     emailToIdMap.clear();
+    searchIndex.clear();
 
     for (const QJsonValue& userValue : usersArray) {
         User user = jsonToUser(userValue.toObject());
         usersById[user.getId()] = user;
+        userIds.observe(user.getId());
         emailToIdMap[user.getEmail()] = user.getId();
+        indexUser(user.getId(), user);
     }
 
     return loadRememberedCredentials();
@@ -103,13 +125,14 @@ bool UserDataManager::initializeFromFile()
 
 bool UserDataManager::saveToFile()
 {
-    QJsonArray usersArray;
+    std::vector<User> users;
+    users.reserve(usersById.size());
     for (const auto& pair : usersById) {
-        usersArray.append(userToJson(pair.second));
+        users.push_back(pair.second);
     }
 
     QString errorMessage;
-    bool success = writeUsersToFile(usersArray, errorMessage);
+    bool success = writeUsersToFile(std::move(users), errorMessage);
     if (!success) {
         qDebug() << "Error saving users file:" << errorMessage;
         return false;
@@ -122,22 +145,30 @@ bool UserDataManager::saveToFile()
     return success;
 }
 
-bool UserDataManager::saveUserData(const User& user, QString& errorMessage)
+bool UserDataManager::saveUserData(const User& userData, QString& errorMessage)
 {
-    if (!validateNewUser(user, errorMessage)) {
+    if (!validateNewUser(userData, errorMessage)) {
         return false;
     }
 
+    // Callers pass either a new plain-text password or the stored hash back unchanged
+    User user = userData;
+    if (!PasswordHasher::isHash(user.getPassword())) {
+        user.setPassword(PasswordHasher::hash(user.getPassword()));
+    }
+
     auto it = emailToIdMap.find(user.getEmail());
     if (it != emailToIdMap.end()) {
         int userId = it->second;
         usersById[userId] = user;
+        indexUser(userId, user);
     } else {
         User newUser = user;
         int newId = generateUserId();
         newUser.setId(newId);
         usersById[newId] = newUser;
         emailToIdMap[newUser.getEmail()] = newId;
+        indexUser(newId, newUser);
     }
 
     dataModified = true;
@@ -145,15 +176,63 @@ bool UserDataManager::saveUserData(const User& user, QString& errorMessage)
     return true;
 }
 
-bool UserDataManager::validateUser(const QString& email, const QString& password)
+void UserDataManager::validateUserAsync(const QString& email, const QString& password,
+                                        QObject* context, std::function<void(bool)> onFinished)
 {
     auto it = emailToIdMap.find(email);
-    if (it == emailToIdMap.end()) {
-        return false;
+    if (it == emailToIdMap.end() || matchesRememberedToken(email, password)) {
+        const bool valid = it != emailToIdMap.end();
+        QTimer::singleShot(0, context, [onFinished, valid]() { onFinished(valid); });
+        return;
+    }
+
+    struct Result {
+        bool valid = false;
+        QString upgradedHash;
+    };
+
+    const int userId = it->second;
+    const QString stored = usersById[userId].getPassword();
+
+    // Parented to the caller so a closed page simply never hears back
+    auto* watcher = new QFutureWatcher<Result>(context);
+    connect(watcher, &QFutureWatcher<Result>::finished, watcher, [this, watcher, userId, stored, onFinished]() {
+        const Result result = watcher->result();
+        watcher->deleteLater();
+        if (result.valid && !result.upgradedHash.isEmpty()) {
+            upgradePasswordHash(userId, stored, result.upgradedHash);
+        }
+        onFinished(result.valid);
+    });
+
+    watcher->setFuture(QtConcurrent::run([password, stored]() {
+        Result result;
+        const PasswordHasher::Verification verification = PasswordHasher::verify(password, stored);
+        result.valid = verification.valid;
+        if (verification.valid && verification.needsRehash) {
+            result.upgradedHash = PasswordHasher::hash(password);
+        }
+        return result;
+    }));
+}
+
+void UserDataManager::upgradePasswordHash(int userId, const QString& previousHash, const QString& upgradedHash)
+{
+    auto it = usersById.find(userId);
+    // The password may have been changed while the worker was hashing
+    if (it == usersById.end() || it->second.getPassword() != previousHash) {
+        return;
     }
 
-    const User& user = usersById[it->second];
-    return user.getPassword() == password;
+    it->second.setPassword(upgradedHash);
+    dataModified = true;
+    qDebug() << "Password hash upgraded and marked for saving at application exit";
+}
+
+bool UserDataManager::matchesRememberedToken(const QString& email, const QString& secret) const
+{
+    return hasRememberedCredentials && email == rememberedEmail &&
+           PasswordHasher::constantTimeEquals(secret.toUtf8(), rememberedToken.toUtf8());
 }
 
 User UserDataManager::getUserData(const QString& email)
@@ -184,6 +263,27 @@ QVector<User> UserDataManager::getAllUsers() const
     return result;
 }
 
+std::vector<int> UserDataManager::getAllUserIds() const
+{
+    std::vector<int> result;
+    result.reserve(usersById.size());
+    for (const auto& pair : usersById) {
+        result.push_back(pair.first);
+    }
+    return result;
+}
+
+std::vector<int> UserDataManager::findUserIds(const QString& query) const
+{
+    return searchIndex.search(query.trimmed());
+}
+
+void UserDataManager::indexUser(int userId, const User& user)
+{
+    // The separator keeps a query from matching across the end of the name
+    searchIndex.insert(userId, user.getName() + QLatin1Char('\n') + user.getEmail());
+}
+
 bool UserDataManager::deleteAccount(const QString& email, QString& errorMessage)
 {
     auto it = emailToIdMap.find(email);
@@ -205,6 +305,7 @@ bool UserDataManager::deleteAccountById(int id, QString& errorMessage)
     }
     const User& user = it->second;
     emailToIdMap.erase(user.getEmail());
+    searchIndex.remove(id);
     usersById.erase(id);
     dataModified = true;
     qDebug() << "User deleted and data marked for saving at application exit";
@@ -216,20 +317,40 @@ bool UserDataManager::emailExists(const QString& email) const
     return emailToIdMap.find(email) != emailToIdMap.end();
 }
 
-int UserDataManager::generateUserId() const {
-    int maxId = 0;
-    for (const auto& pair : usersById) {
-        if (pair.first > maxId) {
-            maxId = pair.first;
-        }
+int UserDataManager::generateUserId() {
+    return userIds.next();
+}
+
+int UserDataManager::reserveUserIds(int count) {
+    return userIds.reserve(count);
+}
+
+void UserDataManager::insertUsers(const std::vector<User>& users) {
+    usersById.reserve(usersById.size() + users.size());
+    emailToIdMap.reserve(emailToIdMap.size() + users.size());
+
+    for (const User& user : users) {
+        usersById[user.getId()] = user;
+        emailToIdMap[user.getEmail()] = user.getId();
+        userIds.observe(user.getId());
+        indexUser(user.getId(), user);
     }
-    return maxId + 1;
+
+    dataModified = true;
+    qDebug() << users.size() << "users inserted and marked for saving at application exit";
 }
 
-bool UserDataManager::saveRememberedCredentials(const QString& email, const QString& password)
+bool UserDataManager::saveRememberedCredentials(const QString& email)
 {
+    if (hasRememberedCredentials && email == rememberedEmail) {
+        return true;
+    }
+
+    QByteArray token(24, Qt::Uninitialized);
+    QRandomGenerator::system()->fillRange(reinterpret_cast<quint32*>(token.data()), token.size() / 4);
+
     rememberedEmail = email;
-    rememberedPassword = password;
+    rememberedToken = QString::fromLatin1(token.toBase64(QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals));
     hasRememberedCredentials = true;
     dataModified = true;
     qDebug() << "Remembered credentials updated and marked for saving at application exit";
@@ -239,25 +360,30 @@ bool UserDataManager::saveRememberedCredentials(const QString& email, const QStr
 bool UserDataManager::clearRememberedCredentials()
 {
     rememberedEmail.clear();
-    rememberedPassword.clear();
+    rememberedToken.clear();
     hasRememberedCredentials = false;
     dataModified = true;
     qDebug() << "Remembered credentials cleared and marked for saving at application exit";
     return true;
 }
 
-bool UserDataManager::getRememberedCredentials(QString& email, QString& password) const
+bool UserDataManager::getRememberedCredentials(QString& email, QString& token) const
 {
     if (!hasRememberedCredentials) {
         return false;
     }
     email = rememberedEmail;
-    password = rememberedPassword;
+    token = rememberedToken;
     return true;
 }
 
 QJsonArray UserDataManager::readUsersFromFile(QString& errorMessage) const
 {
+    QJsonArray snapshotArray;
+    if (BinarySnapshot::readJsonArrayIfPreferred(QDir(dataDir).filePath("users.json"), snapshotArray)) {
+        return snapshotArray;
+    }
+
     QFile file(QDir(dataDir).filePath("users.json"));
     if (!file.open(QIODevice::ReadOnly)) {
         errorMessage = "Could not open users file for reading";
@@ -276,17 +402,16 @@ QJsonArray UserDataManager::readUsersFromFile(QString& errorMessage) const
     return doc.array();
 }
 
-bool UserDataManager::writeUsersToFile(const QJsonArray& users, QString& errorMessage) const
+bool UserDataManager::writeUsersToFile(std::vector<User> users, QString& errorMessage) const
 {
-    QFile file(QDir(dataDir).filePath("users.json"));
-    if (!file.open(QIODevice::WriteOnly)) {
-        errorMessage = "Could not open users file for writing";
-        return false;
-    }
-
-    QJsonDocument doc(users);
-    file.write(doc.toJson());
-    file.close();
+    Q_UNUSED(errorMessage);
+    BinarySnapshot::scheduleJsonArrayWrites(QDir(dataDir).filePath("users.json"), [users = std::move(users)]() {
+        QJsonArray usersArray;
+        for (const User& user : users) {
+            usersArray.append(userToJson(user));
+        }
+        return usersArray;
+    });
     return true;
 }
 
@@ -347,8 +472,13 @@ bool UserDataManager::loadRememberedCredentials()
 
     QJsonObject json = doc.object();
     rememberedEmail = json["email"].toString();
-    rememberedPassword = json["password"].toString();
-    hasRememberedCredentials = !rememberedEmail.isEmpty() && !rememberedPassword.isEmpty();
+    rememberedToken = json["token"].toString();
+    hasRememberedCredentials = !rememberedEmail.isEmpty() && !rememberedToken.isEmpty();
+
+    // Older files kept the raw password; keep the email remembered but never that password
+    if (!hasRememberedCredentials && !rememberedEmail.isEmpty() && json.contains("password")) {
+        saveRememberedCredentials(rememberedEmail);
+    }
     return hasRememberedCredentials;
 }
 
@@ -366,7 +496,7 @@ bool UserDataManager::saveRememberedCredentialsToFile() const
 
     QJsonObject json;
     json["email"] = rememberedEmail;
-    json["password"] = rememberedPassword;
+    json["token"] = rememberedToken;
 
     QJsonDocument doc(json);
     file.write(doc.toJson());
@@ -5,11 +5,15 @@
 #include <QJsonArray>
 #include <QJsonParseError>
 #include "../Model/System/user.h"
+#include "textsearchindex.h"
+#include "idallocator.h"
 #include <QString>
 #include <QVector>
 #include <unordered_map>
+#include <vector>
 #include <QObject>
 #include <QDir>
+#include <functional>
 
 class UserDataManager : public QObject
 {
@@ -25,7 +29,10 @@ public:
 
     // In-memory operations
     bool saveUserData(const User& user, QString& errorMessage);
-    bool validateUser(const QString& email, const QString& password);
+    // Verifies on a worker thread and calls onFinished(valid) on context's thread. A legacy
+    // plain-text or outdated hash is replaced by a fresh hash once the login succeeds.
+    void validateUserAsync(const QString& email, const QString& password,
+                           QObject* context, std::function<void(bool)> onFinished);
     bool emailExists(const QString& email) const;
     User getUserData(const QString& email);
     User getUserDataById(int id);
@@ -40,11 +47,20 @@ public:
     bool validateNewUser(const User& user, QString& errorMessage);
 
     [[nodiscard]] QVector<User> getAllUsers() const;
+    [[nodiscard]] std::vector<int> getAllUserIds() const;
+    // Ids of users whose name or email contains query, case-insensitively, ascending
+    [[nodiscard]] std::vector<int> findUserIds(const QString& query) const;
+    // First of count consecutive user ids reserved for a batch import
+    int reserveUserIds(int count);
+    // Adds users validated elsewhere that already carry reserved ids and hashed passwords;
+    // their emails must not be registered yet
+    void insertUsers(const std::vector<User>& users);
     
-    // Remember me functionality
-    bool saveRememberedCredentials(const QString& email, const QString& password);
+    // Remember me functionality: a random token stands in for the password and is
+    // accepted by validateUserAsync for the remembered email only
+    bool saveRememberedCredentials(const QString& email);
     bool clearRememberedCredentials();
-    bool getRememberedCredentials(QString& email, QString& password) const;
+    bool getRememberedCredentials(QString& email, QString& token) const;
 
     QString getUsersPhotoDir() const { return usersPhotoDir; }
 
@@ -53,15 +69,21 @@ private:
     QString usersPhotoDir;
     std::unordered_map<int, User> usersById;
     std::unordered_map<QString, int> emailToIdMap;
+    TextSearchIndex searchIndex;  // Name and email of every user
+    IdAllocator userIds{"users"};
     bool hasRememberedCredentials = false;
     QString rememberedEmail;
-    QString rememberedPassword;
+    QString rememberedToken;
     bool dataModified = false;  // Track if data has been modified
 
     QJsonArray readUsersFromFile(QString& errorMessage) const;
-    bool writeUsersToFile(const QJsonArray& users, QString& errorMessage) const;
+    // The JSON is built from these copies on the persistence thread
+    bool writeUsersToFile(std::vector<User> users, QString& errorMessage) const;
     static QJsonObject userToJson(const User& user);
     static User jsonToUser(const QJsonObject& json);
+    void indexUser(int userId, const User& user);
+    [[nodiscard]] bool matchesRememberedToken(const QString& email, const QString& secret) const;
+    void upgradePasswordHash(int userId, const QString& previousHash, const QString& upgradedHash);
     bool loadRememberedCredentials();
 
     [[nodiscard]] bool saveRememberedCredentialsToFile() const;
@@ -69,7 +91,7 @@ private:
     [[nodiscard]] bool isEmailValid(const QString& email) const;
     [[nodiscard]] bool isPasswordValid(const QString& password) const;
     [[nodiscard]] bool isEmailUnique(const QString& email) const;
-    [[nodiscard]] int generateUserId() const;
+    int generateUserId();
 };
 
 #endif
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <QJsonArray>
 #include <QDir>
 #include <QDebug>
+#include "persistenceservice.h"
+#include "binarysnapshot.h"
 
 WorkoutDataManager::WorkoutDataManager(QObject* parent)
     : QObject(parent)
@@ -45,6 +47,7 @@ WorkoutDataManager::~WorkoutDataManager() {
     if (dataModified) {
         saveToFile();
     }
+    PersistenceService::instance().flush();
 }
 
 bool WorkoutDataManager::initializeFromFile() {
@@ -64,6 +67,15 @@ bool WorkoutDataManager::loadWorkouts() {
     QDir dir(dataDir);
     QString filePath = dir.absoluteFilePath("workouts.json");
 
+    QJsonArray workoutsArray;
+    if (BinarySnapshot::readJsonArrayIfPreferred(filePath, workoutsArray)) {
+        workouts.clear();
+        for (const QJsonValue& value : workoutsArray) {
+            workouts.append(jsonToWorkout(value.toObject()));
+        }
+        return true;
+    }
+
     if (!QFile::exists(filePath)) {
 
         return false;
@@ -101,7 +113,7 @@ bool WorkoutDataManager::loadWorkouts() {
         return false;
     }
 
-    QJsonArray workoutsArray = root["workouts"].toArray();
+    workoutsArray = root["workouts"].toArray();
     workouts.clear();
 
     for (const QJsonValue& value : workoutsArray) {
@@ -120,21 +132,14 @@ bool WorkoutDataManager::loadWorkouts() {
 }
 
 bool WorkoutDataManager::saveWorkouts() const {
-    QFile file(QDir(dataDir).absoluteFilePath("workouts.json"));
-    if (!file.open(QIODevice::WriteOnly)) {
-        return false;
-    }
-
-    QJsonArray workoutsArray;
-    for (const Workout& workout : workouts) {
-        workoutsArray.append(workoutToJson(workout));
-    }
-
-    QJsonObject root;
-    root["workouts"] = workoutsArray;
-
-    QJsonDocument doc(root);
-    file.write(doc.toJson());
+    // QVector copies are shallow; the JSON is built on the persistence thread
+    BinarySnapshot::scheduleJsonArrayWrites(QDir(dataDir).absoluteFilePath("workouts.json"), [workouts = workouts]() {
+        QJsonArray workoutsArray;
+        for (const Workout& workout : workouts) {
+            workoutsArray.append(workoutToJson(workout));
+        }
+        return workoutsArray;
+    }, "workouts");
     return true;
 }
 
@@ -142,6 +147,15 @@ bool WorkoutDataManager::loadWorkoutLogs() {
     QDir dir(dataDir);
     QString filePath = dir.absoluteFilePath("workout_logs.json");
 
+    QJsonArray logsArray;
+    if (BinarySnapshot::readJsonArrayIfPreferred(filePath, logsArray)) {
+        workoutLogs.clear();
+        for (const QJsonValue& value : logsArray) {
+            workoutLogs.append(jsonToWorkoutLog(value.toObject()));
+        }
+        return true;
+    }
+
     bool fileExists = QFile::exists(filePath);
 
     QFile file(filePath);
@@ -190,7 +204,7 @@ bool WorkoutDataManager::loadWorkoutLogs() {
         return false;
     }
 
-    QJsonArray logsArray = root["logs"].toArray();
+    logsArray = root["logs"].toArray();
     workoutLogs.clear();
 
     for (const QJsonValue& value : logsArray) {
@@ -205,21 +219,13 @@ bool WorkoutDataManager::loadWorkoutLogs() {
 }
 
 bool WorkoutDataManager::saveWorkoutLogs() const {
-    QFile file(QDir(dataDir).absoluteFilePath("workout_logs.json"));
-    if (!file.open(QIODevice::WriteOnly)) {
-        return false;
-    }
-
-    QJsonArray logsArray;
-    for (const WorkoutLog& log : workoutLogs) {
-        logsArray.append(workoutLogToJson(log));
-    }
-
-    QJsonObject root;
-    root["logs"] = logsArray;
-
-    QJsonDocument doc(root);
-    file.write(doc.toJson());
+    BinarySnapshot::scheduleJsonArrayWrites(QDir(dataDir).absoluteFilePath("workout_logs.json"), [logs = workoutLogs]() {
+        QJsonArray logsArray;
+        for (const WorkoutLog& log : logs) {
+            logsArray.append(workoutLogToJson(log));
+        }
+        return logsArray;
+    }, "logs");
     return true;
 }
 
@@ -0,0 +1,151 @@
+#include "attendancestore.h"
+#include <algorithm>
+
+AttendanceRecord AttendanceStore::Partition::record(size_t row) const {
+    AttendanceRecord result;
+    result.classId = classIds[row];
+    result.memberId = memberIds[row];
+    result.date = QDate::fromJulianDay(days[row]);
+    result.attended = attended[row] != 0;
+    result.amountPaid = amounts[row];
+    return result;
+}
+
+void AttendanceStore::append(const AttendanceRecord& record) {
+    if (!record.date.isValid()) {
+        return;
+    }
+
+    Partition& partition = partitions[monthKey(record.date)];
+    const qint64 day = record.date.toJulianDay();
+
+    // Insert after the class's last row on or before this day, keeping arrival order among equals
+    size_t row = partition.size();
+    auto rangeIt = partition.classRows.find(record.classId);
+    if (rangeIt != partition.classRows.end()) {
+        auto first = partition.days.begin() + rangeIt->second.first;
+        auto last = partition.days.begin() + rangeIt->second.second;
+        row = std::upper_bound(first, last, day) - partition.days.begin();
+    } else {
+        auto next = partition.classRows.upper_bound(record.classId);
+        if (next != partition.classRows.end()) {
+            row = next->second.first;
+        }
+    }
+
+    partition.classIds.insert(partition.classIds.begin() + row, record.classId);
+    partition.memberIds.insert(partition.memberIds.begin() + row, record.memberId);
+    partition.days.insert(partition.days.begin() + row, day);
+    partition.attended.insert(partition.attended.begin() + row, record.attended ? 1 : 0);
+    partition.amounts.insert(partition.amounts.begin() + row, record.amountPaid);
+
+    std::pair<size_t, size_t>& range = partition.classRows[record.classId];
+    if (range.first == range.second) {
+        range = {row, row};
+    }
+    range.second++;
+    for (auto it = partition.classRows.upper_bound(record.classId); it != partition.classRows.end(); ++it) {
+        it->second.first++;
+        it->second.second++;
+    }
+
+    if (record.attended) {
+        Partition::ClassTotals& totals = partition.classTotals[record.classId];
+        totals.attended++;
+        totals.revenue += record.amountPaid;
+        partition.attendanceByMember[record.memberId]++;
+    } else {
+        partition.classTotals[record.classId];
+    }
+
+    recordCount++;
+}
+
+void AttendanceStore::clear() {
+    partitions.clear();
+    recordCount = 0;
+}
+
+const AttendanceStore::Partition* AttendanceStore::partitionFor(int year, int month) const {
+    auto it = partitions.find(year * 12 + month - 1);
+    return it != partitions.end() ? &it->second : nullptr;
+}
+
+void AttendanceStore::visitClassRows(int classId, const QDate& startDate, const QDate& endDate,
+                                     const std::function<void(const Partition&, size_t, size_t)>& visit) const {
+    if (!startDate.isValid() || !endDate.isValid() || startDate > endDate) {
+        return;
+    }
+
+    const qint64 firstDay = startDate.toJulianDay();
+    const qint64 lastDay = endDate.toJulianDay();
+
+    auto last = partitions.upper_bound(monthKey(endDate));
+    for (auto it = partitions.lower_bound(monthKey(startDate)); it != last; ++it) {
+        const Partition& partition = it->second;
+        auto rangeIt = partition.classRows.find(classId);
+        if (rangeIt == partition.classRows.end()) {
+            continue;
+        }
+
+        auto classBegin = partition.days.begin() + rangeIt->second.first;
+        auto classEnd = partition.days.begin() + rangeIt->second.second;
+        const size_t begin = std::lower_bound(classBegin, classEnd, firstDay) - partition.days.begin();
+        const size_t end = std::upper_bound(classBegin, classEnd, lastDay) - partition.days.begin();
+        if (begin < end) {
+            visit(partition, begin, end);
+        }
+    }
+}
+
+QVector<AttendanceRecord> AttendanceStore::records(int classId, const QDate& startDate, const QDate& endDate) const {
+    QVector<AttendanceRecord> result;
+    visitClassRows(classId, startDate, endDate, [&result](const Partition& partition, size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            result.append(partition.record(row));
+        }
+    });
+    return result;
+}
+
+int AttendanceStore::attendedCount(int classId, const QDate& date) const {
+    int count = 0;
+    visitClassRows(classId, date, date, [&count](const Partition& partition, size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            count += partition.attended[row];
+        }
+    });
+    return count;
+}
+
+double AttendanceStore::revenue(int classId, const QDate& startDate, const QDate& endDate) const {
+    double total = 0.0;
+    visitClassRows(classId, startDate, endDate, [&total](const Partition& partition, size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            total += partition.amounts[row];
+        }
+    });
+    return total;
+}
+
+void AttendanceStore::forEachRecord(const std::function<void(const AttendanceRecord&)>& callback) const {
+    for (const auto& pair : partitions) {
+        const Partition& partition = pair.second;
+        for (size_t row = 0; row < partition.size(); ++row) {
+            callback(partition.record(row));
+        }
+    }
+}
+
+void AttendanceStore::forEachPartition(const QDate& startDate, const QDate& endDate,
+                                       const std::function<void(const QDate&, const Partition&)>& visit) const {
+    if (!startDate.isValid() || !endDate.isValid() || startDate > endDate) {
+        return;
+    }
+
+    const int firstKey = monthKey(startDate) + (startDate.day() > 1 ? 1 : 0);
+    auto last = partitions.upper_bound(monthKey(endDate));
+    for (auto it = partitions.lower_bound(firstKey); it != last; ++it) {
+        visit(QDate(it->first / 12, it->first % 12 + 1, 1), it->second);
+    }
+}
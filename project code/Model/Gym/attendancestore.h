@@ -0,0 +1,74 @@
+#ifndef ATTENDANCESTORE_H
+#define ATTENDANCESTORE_H
+
+#include <QDate>
+#include <QVector>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// Structure to store attendance data
+struct AttendanceRecord {
+    int classId;
+    int memberId;
+    QDate date;
+    bool attended;
+    double amountPaid;
+};
+
+// Attendance kept column by column and partitioned by calendar month. Inside a
+// partition rows are grouped by class and ordered by day, and each class has its
+// [begin, end) row range, so per-class and per-month questions are sequential
+// passes over a few contiguous arrays instead of scans of every record.
+class AttendanceStore {
+public:
+    struct Partition {
+        std::vector<int> classIds;
+        std::vector<int> memberIds;
+        std::vector<qint64> days;        // Julian day numbers
+        std::vector<quint8> attended;
+        std::vector<double> amounts;
+        // classId -> {first row, one past last row}
+        std::map<int, std::pair<size_t, size_t>> classRows;
+
+        // Month totals kept up to date by append(), so reports never walk the rows
+        struct ClassTotals {
+            int attended = 0;
+            double revenue = 0.0;   // Paid by members who attended
+        };
+        std::map<int, ClassTotals> classTotals;
+        std::unordered_map<int, int> attendanceByMember;   // Attended rows per member
+
+        size_t size() const { return days.size(); }
+        AttendanceRecord record(size_t row) const;
+    };
+
+    void append(const AttendanceRecord& record);
+    void clear();
+    size_t size() const { return recordCount; }
+
+    // Null if nothing was recorded in that month
+    const Partition* partitionFor(int year, int month) const;
+
+    QVector<AttendanceRecord> records(int classId, const QDate& startDate, const QDate& endDate) const;
+    int attendedCount(int classId, const QDate& date) const;
+    double revenue(int classId, const QDate& startDate, const QDate& endDate) const;
+
+    void forEachRecord(const std::function<void(const AttendanceRecord&)>& callback) const;
+    // Calls visit(month, partition) for each month with records whose first day is in [startDate, endDate]
+    void forEachPartition(const QDate& startDate, const QDate& endDate,
+                          const std::function<void(const QDate&, const Partition&)>& visit) const;
+
+private:
+    static int monthKey(const QDate& date) { return date.year() * 12 + date.month() - 1; }
+
+    // Calls visit(partition, begin, end) for the rows of classId within [startDate, endDate]
+    void visitClassRows(int classId, const QDate& startDate, const QDate& endDate,
+                        const std::function<void(const Partition&, size_t, size_t)>& visit) const;
+
+    std::map<int, Partition> partitions;
+    size_t recordCount = 0;
+};
+
+#endif // ATTENDANCESTORE_H
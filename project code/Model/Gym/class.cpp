@@ -45,39 +45,31 @@ int Class::getId() const {return id;}
 
 // Session management
 void Class::addSession(const QDate& date) {
-    sessions.push(date);
+    if (!date.isValid()) {
+        return;
+    }
+
+    auto it = std::lower_bound(sessions.begin(), sessions.end(), date);
+    if (it == sessions.end() || *it != date) {
+        sessions.insert(it, date);
+    }
 }
 
 void Class::removeSession(const QDate& date) {
-    std::queue<QDate> tempSessions;
-    
-    while (!sessions.empty()) {
-        QDate currentDate = sessions.front();
-        sessions.pop();
-        
-        if (currentDate != date) {
-            tempSessions.push(currentDate);
-        }
+    auto it = std::lower_bound(sessions.begin(), sessions.end(), date);
+    if (it != sessions.end() && *it == date) {
+        sessions.erase(it);
     }
-    
-    sessions = tempSessions;
 }
 
-std::queue<QDate> Class::getSessions() const {
-    return sessions;
+QVector<QDate> Class::getSessionsBetween(const QDate& startDate, const QDate& endDate) const {
+    auto first = std::lower_bound(sessions.begin(), sessions.end(), startDate);
+    auto last = std::upper_bound(first, sessions.end(), endDate);
+    return QVector<QDate>(first, last);
 }
 
 bool Class::hasSessionOnDate(const QDate& date) const {
-    std::queue<QDate> tempSessions = sessions;
-    
-    while (!tempSessions.empty()) {
-        if (tempSessions.front() == date) {
-            return true;
-        }
-        tempSessions.pop();
-    }
-    
-    return false;
+    return std::binary_search(sessions.begin(), sessions.end(), date);
 }
 
 // Capacity management
@@ -5,7 +5,7 @@
 #include <QDate>
 #include <QTime>
 #include <QVector>
-#include <queue>
+#include <vector>
 #include <QJsonObject>
 #include <set>
 #include "prioritywaitlist.h"
@@ -31,9 +31,11 @@ public:
 	[[nodiscard]] QString getClassName() const;
 	[[nodiscard]] QString getCoachName() const;
 
+	// Sessions are kept sorted and without duplicates
 	void addSession(const QDate& date);
 	void removeSession(const QDate& date);
-	[[nodiscard]] std::queue<QDate> getSessions() const;
+	[[nodiscard]] const std::vector<QDate>& getSessions() const { return sessions; }
+	[[nodiscard]] QVector<QDate> getSessionsBetween(const QDate& startDate, const QDate& endDate) const;
 	[[nodiscard]] bool hasSessionOnDate(const QDate& date) const;
 
 
@@ -57,7 +59,7 @@ private:
 	int id;
 	QString className;
 	QString coachName;
-	std::queue<QDate> sessions;
+	std::vector<QDate> sessions;
 	QDate fromDate;
 	QDate toDate;
 	int capacity;
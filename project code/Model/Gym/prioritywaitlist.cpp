@@ -1,115 +1,89 @@
 #include "prioritywaitlist.h"
 #include <QDateTime>
 
-void PriorityWaitlist::addMember(int memberId, bool isVIP) {
+PriorityWaitlist::PriorityWaitlist(const PriorityWaitlist& other)
+    : entries(other.entries) {
+    rebuildPositions();
+}
 
-    if (memberMap.find(memberId) != memberMap.end()) {
-        return;
+PriorityWaitlist& PriorityWaitlist::operator=(const PriorityWaitlist& other) {
+    if (this != &other) {
+        entries = other.entries;
+        rebuildPositions();
     }
+    return *this;
+}
 
-    priorityQueue.push(GymWaitlistEntry(memberId, isVIP, QDateTime::currentDateTime()));
+void PriorityWaitlist::rebuildPositions() {
+    positions.clear();
+    positions.reserve(entries.size());
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        positions.emplace(it->memberId, it);
+    }
+}
 
-    memberMap[memberId] = true;
+void PriorityWaitlist::addMember(int memberId, bool isVIP) {
+    addMemberWithTime(memberId, isVIP, QDateTime::currentDateTime());
 }
 
 void PriorityWaitlist::addMemberWithTime(int memberId, bool isVIP, const QDateTime& joinTime) {
 
-    if (memberMap.find(memberId) != memberMap.end()) {
+    if (positions.find(memberId) != positions.end()) {
         return;
     }
 
-    priorityQueue.push(GymWaitlistEntry(memberId, isVIP, joinTime));
-
-    memberMap[memberId] = true;
+    positions.emplace(memberId, entries.emplace(memberId, isVIP, joinTime).first);
 }
 
 bool PriorityWaitlist::removeMember(int memberId) {
 
-    if (memberMap.find(memberId) == memberMap.end()) {
+    auto it = positions.find(memberId);
+    if (it == positions.end()) {
         return false;
     }
 
-    memberMap.erase(memberId);
+    entries.erase(it->second);
+    positions.erase(it);
 
     return true;
 }
 
 int PriorityWaitlist::getNextMember() const {
-    if (priorityQueue.empty()) {
+    if (entries.empty()) {
         return -1;
     }
 
-    std::priority_queue<GymWaitlistEntry> tempQueue = priorityQueue;
-
-    while (!tempQueue.empty()) {
-        GymWaitlistEntry entry = tempQueue.top();
-        tempQueue.pop();
-
-        if (memberMap.find(entry.memberId) != memberMap.end()) {
-            return entry.memberId;
-        }
-    }
-
-    return -1;
+    return entries.begin()->memberId;
 }
 
 bool PriorityWaitlist::contains(int memberId) const {
-    return memberMap.find(memberId) != memberMap.end();
+    return positions.find(memberId) != positions.end();
 }
 
 std::vector<int> PriorityWaitlist::getAllMembers() const {
     std::vector<int> result;
+    result.reserve(entries.size());
 
-    if (priorityQueue.empty()) {
-        return result;
-    }
-
-    std::priority_queue<GymWaitlistEntry> tempQueue = priorityQueue;
-
-    while (!tempQueue.empty()) {
-        GymWaitlistEntry entry = tempQueue.top();
-        tempQueue.pop();
-
-        if (memberMap.find(entry.memberId) != memberMap.end()) {
-            result.push_back(entry.memberId);
-        }
+    for (const GymWaitlistEntry& entry : entries) {
+        result.push_back(entry.memberId);
     }
 
     return result;
 }
 
 std::vector<GymWaitlistEntry> PriorityWaitlist::getAllEntries() const {
-    std::vector<GymWaitlistEntry> result;
-
-    if (priorityQueue.empty()) {
-        return result;
-    }
-
-    std::priority_queue<GymWaitlistEntry> tempQueue = priorityQueue;
-
-    while (!tempQueue.empty()) {
-        GymWaitlistEntry entry = tempQueue.top();
-        tempQueue.pop();
-
-        if (memberMap.find(entry.memberId) != memberMap.end()) {
-            result.push_back(entry);
-        }
-    }
-
-    return result;
+    return std::vector<GymWaitlistEntry>(entries.begin(), entries.end());
 }
 
 size_t PriorityWaitlist::size() const {
-    return memberMap.size();
+    return positions.size();
 }
 
 bool PriorityWaitlist::isEmpty() const {
-    return memberMap.empty();
+    return positions.empty();
 }
 
 void PriorityWaitlist::clear() {
-    while (!priorityQueue.empty()) {
-        priorityQueue.pop();
-    }
-    memberMap.clear();
-}
\ No newline at end of file
+    entries.clear();
+    positions.clear();
+}
@@ -1,7 +1,7 @@
 #ifndef PRIORITYWAITLIST_H
 #define PRIORITYWAITLIST_H
 
-#include <queue>
+#include <set>
 #include <vector>
 #include <unordered_map>
 #include <QDateTime>
@@ -13,19 +13,17 @@ struct GymWaitlistEntry {
 
     GymWaitlistEntry(int id, bool vip, const QDateTime& time)
         : memberId(id), isVIP(vip), joinTime(time) {}
-
-    bool operator<(const GymWaitlistEntry& other) const {
-
-        if (isVIP != other.isVIP) {
-            return !isVIP;
-        }
-
-        return joinTime > other.joinTime;
-    }
 };
 
 class PriorityWaitlist {
 public:
+    PriorityWaitlist() = default;
+    // positions points into entries, so copies rebuild it against their own set;
+    // moves keep the nodes and with them the iterators
+    PriorityWaitlist(const PriorityWaitlist& other);
+    PriorityWaitlist& operator=(const PriorityWaitlist& other);
+    PriorityWaitlist(PriorityWaitlist&&) noexcept = default;
+    PriorityWaitlist& operator=(PriorityWaitlist&&) noexcept = default;
 
     void addMember(int memberId, bool isVIP);
 
@@ -48,8 +46,24 @@ public:
     void clear();
 
 private:
-    std::priority_queue<GymWaitlistEntry> priorityQueue;
-    std::unordered_map<int, bool> memberMap;
+    // VIPs first, then by join time; the member id keeps equal timestamps distinct
+    struct EntryOrder {
+        bool operator()(const GymWaitlistEntry& a, const GymWaitlistEntry& b) const {
+            if (a.isVIP != b.isVIP) {
+                return a.isVIP;
+            }
+            if (a.joinTime != b.joinTime) {
+                return a.joinTime < b.joinTime;
+            }
+            return a.memberId < b.memberId;
+        }
+    };
+    using EntrySet = std::set<GymWaitlistEntry, EntryOrder>;
+
+    void rebuildPositions();
+
+    EntrySet entries;
+    std::unordered_map<int, EntrySet::iterator> positions;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -11,7 +11,7 @@ Subscription::Subscription(SubscriptionType type, const QDate& startDate)
 
 // Call this to return a snapshot of the current date (time logic)
 QDate Subscription::current_date() {
-    return timeLogicInstance.getCurrentTime().date();
+    return timeLogicInstance.getCurrentDate();
 }
 
 SubscriptionType Subscription::getType() const {
@@ -51,7 +51,7 @@ double Subscription::getTotalPrice() const {
 
 
 bool Subscription::isActive() const {
-    return active && endDate >= current_date();
+    return active && endDate.toJulianDay() >= timeLogicInstance.currentJulianDay();
 }
 
 bool Subscription::isVIP() const {
@@ -155,7 +155,10 @@ bool Subscription::isEligibleForEarlyRenewal() const {
 }
 
 int Subscription::getDaysUntilExpiry() const {
-    return current_date().daysTo(endDate);
+    if (!endDate.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(endDate.toJulianDay() - timeLogicInstance.currentJulianDay());
 }
 
 void Subscription::calculateEndDate() {
@@ -44,6 +44,7 @@ public:
     static QString typeToString(SubscriptionType type);
     static SubscriptionType stringToType(const QString& typeStr);
     static double getEarlyRenewalDiscountPercent(int daysBeforeExpiry);
+    static constexpr int EARLY_RENEWAL_THRESHOLD = 30;  // Days before expiry for early renewal
 
 private:
     SubscriptionType type;
@@ -53,7 +54,6 @@ private:
     bool vip;
     
     void calculateEndDate();
-    static constexpr int EARLY_RENEWAL_THRESHOLD = 30;  // Days before expiry for early renewal
     static constexpr double MAX_EARLY_RENEWAL_DISCOUNT = 0.15;  // 15% maximum discount
 };
 
@@ -1,62 +1,66 @@
 #ifndef BOOKING_H
 #define BOOKING_H
 
-#include <QObject>
 #include <QDateTime>
-#include <QString>
-#include "../System/user.h"
-#include "Court.h"
+#include <QtGlobal>
+#include <limits>
 
+// Compact booking record: court and user are referenced by id and resolved
+// through PadelDataManager / UserDataManager when needed.
 class Booking {
 public:
+    static constexpr qint32 InvalidTime = std::numeric_limits<qint32>::min();
+
     // Constructors
     Booking();
-    Booking(int bookingId, const Court& court, const QDateTime& startTime, 
-            const QDateTime& endTime, const User& user);
-    Booking(const Booking& other);
-    Booking& operator=(const Booking& other);
+    Booking(int bookingId, int courtId, int userId,
+            const QDateTime& startTime, const QDateTime& endTime);
 
     // Getters
-    int getBookingId() const;
-    const Court& getCourt() const;
-    const User& getUser() const;
-    const QDateTime& getStartTime() const;
-    const QDateTime& getEndTime() const;
-    double getPrice() const;
-    bool isVip() const;
-    bool isCancelled() const;
-    bool isFromWaitlist() const;
-    int getMemberId() const;
-    int getCourtId() const;
-    int getUserId() const;
+    int getBookingId() const { return m_bookingId; }
+    int getCourtId() const { return m_courtId; }
+    int getUserId() const { return m_userId; }
+    int getMemberId() const { return m_userId; }
+    QDateTime getStartTime() const;
+    QDateTime getEndTime() const;
+    qint32 getStartMinutes() const { return m_startMinutes; }
+    qint32 getEndMinutes() const { return m_endMinutes; }
+    double getPrice() const { return m_price; }
+    bool isVip() const { return m_isVip; }
+    bool isCancelled() const { return m_isCancelled; }
+    bool isFromWaitlist() const { return m_isFromWaitlist; }
 
     // Setters
-    void setBookingId(int id);
-    void setCourt(const Court& court);
-    void setUser(const User& user);
+    void setBookingId(int id) { m_bookingId = id; }
+    void setCourtId(int id) { m_courtId = id; }
+    void setUserId(int id) { m_userId = id; }
     void setStartTime(const QDateTime& time);
     void setEndTime(const QDateTime& time);
-    void setPrice(double price);
-    void setVip(bool vip);
-    void setCancelled(bool cancelled);
-    void setIsFromWaitlist(bool fromWaitlist);
-    void setCourtId(int id);
-    void setUserId(int id);
+    void setStartMinutes(qint32 minutes) { m_startMinutes = minutes; }
+    void setEndMinutes(qint32 minutes) { m_endMinutes = minutes; }
+    void setPrice(double price) { m_price = price; }
+    void setVip(bool vip) { m_isVip = vip; }
+    void setCancelled(bool cancelled) { m_isCancelled = cancelled; }
+    void setIsFromWaitlist(bool fromWaitlist) { m_isFromWaitlist = fromWaitlist; }
 
     // Booking operations
     void cancel();
     void reschedule(const QDateTime& newStartTime, const QDateTime& newEndTime);
 
+    // Time conversion helpers (minutes since the Unix epoch)
+    static qint32 toEpochMinutes(const QDateTime& time);
+    static QDateTime fromEpochMinutes(qint32 minutes);
+
 private:
     int m_bookingId;
-    Court m_court;
-    User m_user;
-    QDateTime m_startTime;
-    QDateTime m_endTime;
+    int m_courtId;
+    int m_userId;
+    qint32 m_startMinutes;
+    qint32 m_endMinutes;
     double m_price;
     bool m_isVip;
     bool m_isCancelled;
     bool m_isFromWaitlist;
 };
 
-#endif // BOOKING_H
\ No newline at end of file
+#endif // BOOKING_H
@@ -0,0 +1,82 @@
+#include "CourtWaitlist.h"
+#include <algorithm>
+#include <iterator>
+
+void CourtWaitlist::push(const WaitlistEntry& entry) {
+    byMember.emplace(entry.memberId, entries.insert(entry));
+}
+
+WaitlistEntry CourtWaitlist::takeFront() {
+    WaitlistEntry entry = *entries.begin();
+    erase(entries.begin());
+    return entry;
+}
+
+int CourtWaitlist::removeMember(int memberId) {
+    auto range = byMember.equal_range(memberId);
+    int removed = 0;
+    for (auto it = range.first; it != range.second; ++it) {
+        entries.erase(it->second);
+        removed++;
+    }
+    byMember.erase(range.first, range.second);
+    return removed;
+}
+
+int CourtWaitlist::removeMemberOnDate(int memberId, const QDate& date) {
+    auto range = byMember.equal_range(memberId);
+    int removed = 0;
+    for (auto it = range.first; it != range.second;) {
+        if (it->second->requestedTime.date() == date) {
+            entries.erase(it->second);
+            it = byMember.erase(it);
+            removed++;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+int CourtWaitlist::position(int memberId) const {
+    auto range = byMember.equal_range(memberId);
+    if (range.first == range.second) {
+        return -1;
+    }
+
+    const_iterator first = range.first->second;
+    for (auto it = std::next(range.first); it != range.second; ++it) {
+        if (EntryOrder()(*it->second, *first)) {
+            first = it->second;
+        }
+    }
+
+    return static_cast<int>(std::distance(entries.begin(), first)) + 1;
+}
+
+std::vector<WaitlistEntry> CourtWaitlist::entriesForMember(int memberId) const {
+    std::vector<WaitlistEntry> result;
+    auto range = byMember.equal_range(memberId);
+    for (auto it = range.first; it != range.second; ++it) {
+        result.push_back(*it->second);
+    }
+
+    std::sort(result.begin(), result.end(), EntryOrder());
+    return result;
+}
+
+void CourtWaitlist::clear() {
+    entries.clear();
+    byMember.clear();
+}
+
+void CourtWaitlist::erase(const_iterator it) {
+    auto range = byMember.equal_range(it->memberId);
+    for (auto entryIt = range.first; entryIt != range.second; ++entryIt) {
+        if (entryIt->second == it) {
+            byMember.erase(entryIt);
+            break;
+        }
+    }
+    entries.erase(it);
+}
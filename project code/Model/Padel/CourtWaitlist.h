@@ -0,0 +1,72 @@
+#ifndef COURTWAITLIST_H
+#define COURTWAITLIST_H
+
+#include <QDateTime>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+// Structure to store waitlist entries
+struct WaitlistEntry {
+    int memberId;
+    int courtId;
+    QDateTime requestedTime;
+    bool isVIP;
+    int priority;
+};
+
+// Waitlist of one court, kept in service order: VIPs first, then by priority and
+// requested time, first come first served among equals. Entries are also indexed
+// by member so lookups and removals do not walk or rebuild the whole list.
+class CourtWaitlist {
+    struct EntryOrder {
+        bool operator()(const WaitlistEntry& a, const WaitlistEntry& b) const {
+            if (a.isVIP != b.isVIP) {
+                return a.isVIP;
+            }
+            if (a.priority != b.priority) {
+                return a.priority > b.priority;
+            }
+            return a.requestedTime < b.requestedTime;
+        }
+    };
+    using EntrySet = std::multiset<WaitlistEntry, EntryOrder>;
+
+public:
+    using const_iterator = EntrySet::const_iterator;
+
+    CourtWaitlist() = default;
+    // byMember points into entries, so a memberwise copy would point into the source;
+    // moves keep the nodes and with them the iterators
+    CourtWaitlist(const CourtWaitlist&) = delete;
+    CourtWaitlist& operator=(const CourtWaitlist&) = delete;
+    CourtWaitlist(CourtWaitlist&&) noexcept = default;
+    CourtWaitlist& operator=(CourtWaitlist&&) noexcept = default;
+
+    void push(const WaitlistEntry& entry);
+    const WaitlistEntry& front() const { return *entries.begin(); }
+    WaitlistEntry takeFront();
+
+    // Return the number of entries removed
+    int removeMember(int memberId);
+    int removeMemberOnDate(int memberId, const QDate& date);
+
+    bool contains(int memberId) const { return byMember.find(memberId) != byMember.end(); }
+    // 1-based position of the member's first entry, or -1
+    int position(int memberId) const;
+    std::vector<WaitlistEntry> entriesForMember(int memberId) const;
+
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+    void clear();
+
+private:
+    void erase(const_iterator it);
+
+    EntrySet entries;
+    std::unordered_multimap<int, const_iterator> byMember;
+};
+
+#endif // COURTWAITLIST_H
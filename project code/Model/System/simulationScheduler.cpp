@@ -0,0 +1,86 @@
+#include "simulationScheduler.h"
+#include "timeLogic.h"
+#include <algorithm>
+#include <cmath>
+
+SimulationScheduler& SimulationScheduler::instance() {
+    static SimulationScheduler scheduler;
+    return scheduler;
+}
+
+SimulationScheduler::SimulationScheduler() {
+    wakeTimer.setSingleShot(true);
+    wakeTimer.setTimerType(Qt::PreciseTimer);
+    connect(&wakeTimer, &QTimer::timeout, this, &SimulationScheduler::dispatchDueEvents);
+    connect(&timeLogicInstance, &TimeLogic::clockAdjusted, this, &SimulationScheduler::rearm);
+}
+
+SimulationScheduler::EventId SimulationScheduler::scheduleAt(const QDateTime& dueTime, QObject* context,
+                                                             std::function<void()> callback) {
+    if (!dueTime.isValid() || !callback) {
+        return 0;
+    }
+
+    const EventId eventId = nextEventId++;
+    events.emplace(eventId, Event{QPointer<QObject>(context), std::move(callback)});
+
+    const bool becomesEarliest = deadlines.empty() || dueTime.toMSecsSinceEpoch() < deadlines.top().dueMs;
+    deadlines.push(HeapEntry{dueTime.toMSecsSinceEpoch(), eventId});
+
+    if (becomesEarliest) {
+        rearm();
+    }
+    return eventId;
+}
+
+void SimulationScheduler::cancel(EventId eventId) {
+    events.erase(eventId);
+}
+
+QDateTime SimulationScheduler::nextMidnight() {
+    return QDateTime(timeLogicInstance.getCurrentTime().date().addDays(1), QTime(0, 0));
+}
+
+void SimulationScheduler::dispatchDueEvents() {
+    const qint64 now = timeLogicInstance.getCurrentTime().toMSecsSinceEpoch();
+
+    // Callbacks may schedule or cancel events, so take each one off the heap first
+    while (!deadlines.empty() && deadlines.top().dueMs <= now) {
+        const EventId eventId = deadlines.top().eventId;
+        deadlines.pop();
+
+        auto it = events.find(eventId);
+        if (it == events.end()) {
+            continue;
+        }
+
+        Event event = std::move(it->second);
+        events.erase(it);
+
+        if (event.context) {
+            event.callback();
+        }
+    }
+
+    rearm();
+}
+
+void SimulationScheduler::rearm() {
+    while (!deadlines.empty() && events.find(deadlines.top().eventId) == events.end()) {
+        deadlines.pop();
+    }
+
+    if (deadlines.empty() || timeLogicInstance.isPaused()) {
+        wakeTimer.stop();
+        return;
+    }
+
+    const qint64 simulatedDelayMs = deadlines.top().dueMs - timeLogicInstance.getCurrentTime().toMSecsSinceEpoch();
+    if (simulatedDelayMs <= 0) {
+        wakeTimer.start(0);
+        return;
+    }
+
+    const double realDelayMs = std::ceil(simulatedDelayMs / static_cast<double>(timeLogicInstance.getMultiplier()));
+    wakeTimer.start(static_cast<int>(std::min<double>(realDelayMs, MaxWakeIntervalMs)));
+}
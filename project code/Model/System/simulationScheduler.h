@@ -0,0 +1,65 @@
+#ifndef SIMULATIONSCHEDULER_H
+#define SIMULATIONSCHEDULER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QDateTime>
+#include <QTimer>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+// Deadlines on the simulated clock (subscription ends, session dates, day changes).
+// Events sit in a min-heap keyed on simulated time; a single timer is armed for the
+// earliest one, scaled by the current multiplier, and re-armed whenever the clock is
+// paused, sped up or jumps ahead. Callbacks run on the GUI thread, and the scheduler
+// must only be used from that thread.
+class SimulationScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    using EventId = quint64;
+
+    static SimulationScheduler& instance();
+
+    // Runs callback once simulated time reaches dueTime (immediately if it already has).
+    // The event is dropped if context is destroyed first.
+    EventId scheduleAt(const QDateTime& dueTime, QObject* context, std::function<void()> callback);
+    void cancel(EventId eventId);
+
+    // Start of the next simulated day
+    static QDateTime nextMidnight();
+
+private slots:
+    void dispatchDueEvents();
+    void rearm();
+
+private:
+    SimulationScheduler();
+    SimulationScheduler(const SimulationScheduler&) = delete;
+    SimulationScheduler& operator=(const SimulationScheduler&) = delete;
+
+    struct HeapEntry {
+        qint64 dueMs;
+        EventId eventId;
+        bool operator>(const HeapEntry& other) const {
+            return dueMs != other.dueMs ? dueMs > other.dueMs : eventId > other.eventId;
+        }
+    };
+
+    struct Event {
+        QPointer<QObject> context;
+        std::function<void()> callback;
+    };
+
+    // Cancelled events stay in the heap and are skipped when they reach the top
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> deadlines;
+    std::unordered_map<EventId, Event> events;
+    EventId nextEventId = 1;
+    QTimer wakeTimer;
+
+    static constexpr int MaxWakeIntervalMs = 60 * 60 * 1000;
+};
+
+#endif // SIMULATIONSCHEDULER_H
@@ -1,72 +1,142 @@
 #include "timeLogic.h"
 #include <QDebug>
-#include <QThread>
 #include "../../DataManager/memberdatamanager.h"
 #include "Widgets/Notifications/NotificationManager.h"
 
 TimeLogic::TimeLogic()
-    : multiplier(1.0f), paused(false), running(true), currentMemberId(-1), memberDataManager(nullptr) {
-    currentTime = QDateTime::currentDateTime();
-    start();  // Start the thread
+    : currentMemberId(-1), memberDataManager(nullptr) {
+    QMutexLocker locker(&anchorMutex);
+    publishAnchor(QDateTime::currentMSecsSinceEpoch(), 1.0, false);
 }
 
-TimeLogic::~TimeLogic() {
-    {
-        QMutexLocker locker(&mutex);
-        running = false;
-        paused = false;
-    }
-    pauseCond.wakeAll(); // In case it's paused
-    wait(); // Wait for thread to finish
+qint64 TimeLogic::steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-void TimeLogic::run() {
+qint64 TimeLogic::currentMSecsSinceEpoch() const {
     while (true) {
-        {
-            QMutexLocker locker(&mutex);
-            if (!running)
-                break;
-            if (paused)
-                pauseCond.wait(&mutex);
+        const quint32 sequence = anchorSequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            // A writer is publishing a new anchor
+            continue;
         }
 
-        QThread::msleep(static_cast<unsigned long>(1000.0 / multiplier));
+        const qint64 simulatedMs = anchorSimulatedMs.load(std::memory_order_relaxed);
+        const qint64 steadyNs = anchorSteadyNs.load(std::memory_order_relaxed);
+        const double multiplier = anchorMultiplier.load(std::memory_order_relaxed);
+        const bool paused = anchorPaused.load(std::memory_order_relaxed);
 
-        {
-            QMutexLocker locker(&mutex);
-            currentTime = currentTime.addSecs(1);
-            qDebug() << currentTime.toString("ddd MMM dd hh:mm:ss yyyy");
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (anchorSequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
         }
+
+        if (paused) {
+            return simulatedMs;
+        }
+        const double elapsedMs = (steadyNowNs() - steadyNs) / 1e6;
+        return simulatedMs + static_cast<qint64>(elapsedMs * multiplier);
     }
 }
 
+void TimeLogic::publishAnchor(qint64 simulatedMs, double multiplier, bool paused) {
+    anchorSequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    anchorSimulatedMs.store(simulatedMs, std::memory_order_relaxed);
+    anchorSteadyNs.store(steadyNowNs(), std::memory_order_relaxed);
+    anchorMultiplier.store(multiplier, std::memory_order_relaxed);
+    anchorPaused.store(paused, std::memory_order_relaxed);
+
+    anchorSequence.fetch_add(1, std::memory_order_release);
+}
+
 void TimeLogic::pauseTime() {
-    QMutexLocker locker(&mutex);
-    paused = !paused;
-    if (!paused)
-        pauseCond.wakeAll();
+    {
+        QMutexLocker locker(&anchorMutex);
+        publishAnchor(currentMSecsSinceEpoch(), anchorMultiplier.load(),
+                      !anchorPaused.load());
+    }
+    emit clockAdjusted();
 }
 
 void TimeLogic::setMultiplier(float m) {
-    QMutexLocker locker(&mutex);
-    multiplier = (m > 0.0f) ? m : 1.0f;
+    {
+        QMutexLocker locker(&anchorMutex);
+        publishAnchor(currentMSecsSinceEpoch(), (m > 0.0f) ? m : 1.0f, anchorPaused.load());
+    }
+    emit clockAdjusted();
 }
 float TimeLogic::getMultiplier() {
-    return multiplier;
+    return static_cast<float>(anchorMultiplier.load());
+}
+bool TimeLogic::isPaused() const {
+    return anchorPaused.load();
 }
 void TimeLogic::incrementDays(int i) {
-    QMutexLocker locker(&mutex);
-    currentTime = currentTime.addDays(i);
+    {
+        QMutexLocker locker(&anchorMutex);
+        QDateTime shifted = QDateTime::fromMSecsSinceEpoch(currentMSecsSinceEpoch()).addDays(i);
+        publishAnchor(shifted.toMSecsSinceEpoch(), anchorMultiplier.load(), anchorPaused.load());
+    }
+    emit clockAdjusted();
 }
 
 QDateTime TimeLogic::getCurrentTime() {
-    QMutexLocker locker(&mutex);
-    return currentTime;
+    return QDateTime::fromMSecsSinceEpoch(currentMSecsSinceEpoch());
+}
+
+qint64 TimeLogic::currentJulianDay() {
+    const qint64 now = currentMSecsSinceEpoch();
+
+    while (true) {
+        const quint32 sequence = daySequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            continue;
+        }
+
+        const qint64 dayStart = cachedDayStartMs.load(std::memory_order_relaxed);
+        const qint64 dayEnd = cachedDayEndMs.load(std::memory_order_relaxed);
+        const qint64 julianDay = cachedJulianDay.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (daySequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        if (now >= dayStart && now < dayEnd) {
+            return julianDay;
+        }
+        break;
+    }
+
+    return refreshCachedDay(now);
+}
+
+qint64 TimeLogic::refreshCachedDay(qint64 simulatedMs) {
+    QMutexLocker locker(&dayMutex);
+
+    const QDate date = QDateTime::fromMSecsSinceEpoch(simulatedMs).date();
+    const qint64 julianDay = date.toJulianDay();
+
+    daySequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    cachedDayStartMs.store(QDateTime(date, QTime(0, 0)).toMSecsSinceEpoch(), std::memory_order_relaxed);
+    cachedDayEndMs.store(QDateTime(date.addDays(1), QTime(0, 0)).toMSecsSinceEpoch(), std::memory_order_relaxed);
+    cachedJulianDay.store(julianDay, std::memory_order_relaxed);
+
+    daySequence.fetch_add(1, std::memory_order_release);
+    return julianDay;
+}
+
+QDate TimeLogic::getCurrentDate() {
+    return QDate::fromJulianDay(currentJulianDay());
 }
 
 QString TimeLogic::getFormattedTime() {
-    QMutexLocker locker(&mutex);
-    return currentTime.toString("ddd MMM dd hh:mm:ss yyyy");
+    return getCurrentTime().toString("ddd MMM dd hh:mm:ss yyyy");
 }
 void TimeLogic::getRemindersSubEnd() {
     if (!hasActiveSubscription()) {
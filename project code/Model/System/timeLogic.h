@@ -6,38 +6,61 @@
 #include <chrono>
 #include <iostream>
 #include <QMutex>
-#include <QWaitCondition>
 #include <QDateTime>
+#include <QObject>
 #include <QThread>
 using namespace std;
 class MemberDataManager;
-class TimeLogic : public QThread {
+
+// Simulated clock. The simulated time is derived from an anchor (simulated time at a
+// point on the monotonic clock) plus the elapsed real time scaled by the multiplier,
+// so nothing ticks in the background. The anchor is published through a sequence lock:
+// readers never block, and the rare writers serialise on anchorMutex.
+class TimeLogic : public QObject {
     Q_OBJECT
 
 private:
-    QDateTime currentTime;
-    float multiplier;
-    bool paused;
-    bool running;
-    QMutex mutex;
-    QWaitCondition pauseCond;
+    std::atomic<quint32> anchorSequence{0};
+    std::atomic<qint64> anchorSimulatedMs{0};
+    std::atomic<qint64> anchorSteadyNs{0};
+    std::atomic<double> anchorMultiplier{1.0};
+    std::atomic<bool> anchorPaused{false};
+    QMutex anchorMutex;
+    // Cached simulated day: its Julian day number and [start, end) in simulated ms.
+    // Refreshed by the first reader that finds the clock outside it.
+    std::atomic<quint32> daySequence{0};
+    std::atomic<qint64> cachedDayStartMs{0};
+    std::atomic<qint64> cachedDayEndMs{0};
+    std::atomic<qint64> cachedJulianDay{0};
+    QMutex dayMutex;
     int currentMemberId;
     MemberDataManager* memberDataManager;
 
-    void run() override;
+    static qint64 steadyNowNs();
+    qint64 currentMSecsSinceEpoch() const;
+    // Caller holds anchorMutex
+    void publishAnchor(qint64 simulatedMs, double multiplier, bool paused);
+    qint64 refreshCachedDay(qint64 simulatedMs);
 public:
     TimeLogic();
-    ~TimeLogic() override;
     void pauseTime();
     float getMultiplier();
+    bool isPaused() const;
     void setMultiplier(float newMultiplier);
     void incrementDays(int i);
     QDateTime getCurrentTime();
+    // Current simulated date without building a QDateTime; lock-free while the day lasts
+    qint64 currentJulianDay();
+    QDate getCurrentDate();
 	QString getFormattedTime();
     void getRemindersSubEnd();
     bool hasActiveSubscription() const;
     void setCurrentMemberId(int memberId);
     void setMemberDataManager(MemberDataManager* dataManager);
+
+signals:
+    // Pause, multiplier or date jump: anything that moves deadlines on the real clock
+    void clockAdjusted();
 };
 extern TimeLogic timeLogicInstance;
 
@@ -4,6 +4,9 @@
 #include <QLabel>
 #include <QProgressBar>
 #include <QTimer>
+#include <QtConcurrent/QtConcurrent>
+#include <QHash>
+#include <vector>
 #include "../DataManager/userdatamanager.h"
 #include "../DataManager/memberdatamanager.h"
 #include "../DataManager/classdatamanager.h"
@@ -27,10 +30,91 @@ Revenue::Revenue(UserDataManager* userDataManager, MemberDataManager* memberData
     , padelManager(nullptr)
 {
     setupUI();
+
+    refreshTimer.setSingleShot(true);
+    refreshTimer.setInterval(RefreshDebounceMs);
+    connect(&refreshTimer, &QTimer::timeout, this, &Revenue::startRefresh);
+    connect(&figuresWatcher, &QFutureWatcher<RevenueFigures>::finished, this, [this]() {
+        try {
+            applyFigures(figuresWatcher.result());
+        } catch (const std::exception& e) {
+            qDebug() << "Error updating revenue data:" << e.what();
+        }
+        if (refreshPending) {
+            refreshPending = false;
+            startRefresh();
+        }
+    });
+
     // Call updateData after UI is set up
     QTimer::singleShot(0, this, &Revenue::updateData);
 }
 
+Revenue::~Revenue()
+{
+    figuresWatcher.waitForFinished();
+}
+
+namespace {
+
+// Everything the aggregation needs, taken on the GUI thread as plain or implicitly shared
+// values; only the user id list is an O(users) copy
+struct RevenueSnapshot {
+    std::vector<int> userIds;
+    QHash<int, bool> membership;                // userId -> VIP
+    MonthlyReport currentReport;
+    MonthlyReport previousReport;
+    bool hasCourtData{false};
+    PadelDataManager::BookingTotals courtTotals;
+};
+
+RevenueFigures computeFigures(const RevenueSnapshot& snapshot)
+{
+    RevenueFigures figures;
+
+    int vipMembers = 0;
+    for (int userId : snapshot.userIds) {
+        auto it = snapshot.membership.constFind(userId);
+        if (userId > 0 && it != snapshot.membership.constEnd()) {
+            figures.totalMembers++;
+            vipMembers += it.value();
+        }
+    }
+    figures.vipPercentage = figures.totalMembers > 0 ? (vipMembers * 100) / figures.totalMembers : 0;
+
+    const MonthlyReport& currentReport = snapshot.currentReport;
+    figures.classesHeld = currentReport.totalClassesHeld;
+    figures.classRevenue = currentReport.totalRevenue;
+    figures.attendanceRate = currentReport.totalClassesHeld > 0 ?
+        (currentReport.totalAttendance * 100) / (currentReport.totalClassesHeld * 30) : 0;
+    figures.activeMembers = currentReport.totalActiveMembers;
+    figures.activeRate = figures.totalMembers > 0 ?
+        (currentReport.totalActiveMembers * 100) / figures.totalMembers : 0;
+    figures.revenuePerMember = figures.totalMembers > 0 ? currentReport.totalRevenue / figures.totalMembers : 0;
+
+    // A month without data reports zeros, which leaves growth at 0
+    const MonthlyReport& prevReport = snapshot.previousReport;
+    if (prevReport.totalRevenue > 0) {
+        figures.revenueGrowth = ((currentReport.totalRevenue - prevReport.totalRevenue) * 100)
+                                / prevReport.totalRevenue;
+    }
+    if (prevReport.totalActiveMembers > 0) {
+        figures.memberGrowth = ((currentReport.totalActiveMembers - prevReport.totalActiveMembers) * 100)
+                               / prevReport.totalActiveMembers;
+    }
+
+    if (snapshot.hasCourtData) {
+        const PadelDataManager::BookingTotals& courts = snapshot.courtTotals;
+        figures.courtUtilization = courts.totalCourts > 0 ? (courts.bookedCourts * 100) / courts.totalCourts : 0;
+        figures.vipBookingRate = courts.bookings > 0 ? (courts.vipBookings * 100) / courts.bookings : 0;
+        figures.hasCourtData = true;
+    }
+
+    return figures;
+}
+
+} // namespace
+
 void Revenue::setupUI()
 {
     // Main layout
@@ -102,6 +186,11 @@ void Revenue::updateMetrics(QLabel* label, QProgressBar* bar, const QString& tex
 }
 
 void Revenue::updateData()
+{
+    refreshTimer.start();
+}
+
+void Revenue::startRefresh()
 {
     // Check all required pointers
     if (!memberManager || !classManager || !userManager || 
@@ -111,113 +200,64 @@ void Revenue::updateData()
         return;
     }
 
-    try {
-        QDate currentDate = timeLogicInstance.getCurrentTime().date();
-        QDate monthStart(currentDate.year(), currentDate.month(), 1);
-        QDate previousMonthStart = monthStart.addMonths(-1);
+    if (figuresWatcher.isRunning()) {
+        refreshPending = true;
+        return;
+    }
 
-        // Get reports
-        QVector<MonthlyReport> currentMonthReports = classManager->getMonthlyReports(monthStart, currentDate);
-        MonthlyReport currentReport;
+    QDate currentDate = timeLogicInstance.getCurrentTime().date();
+    QDate monthStart(currentDate.year(), currentDate.month(), 1);
+    QDate previousMonthStart = monthStart.addMonths(-1);
 
-        // Generate report if none exists
-        if (currentMonthReports.isEmpty()) {
-            currentReport = classManager->generateMonthlyReport(monthStart);
-        } else {
-            currentReport = currentMonthReports.first();
-        }
+    RevenueSnapshot snapshot;
+    snapshot.userIds = userManager->getAllUserIds();
+    snapshot.membership = memberManager->getMembershipSnapshot();
+    if (padelManager) {
+        // Summed from the booking index, so this stays cheap on the GUI thread
+        snapshot.courtTotals = padelManager->getBookingTotals();
+        snapshot.hasCourtData = true;
+    }
 
-        // Get member data
-        QVector<User> allUsers = userManager->getAllUsers();
-        int totalMembers = 0, vipMembers = 0;
-        
-        for (const User& user : allUsers) {
-            if (user.getId() > 0 && memberManager->userIsMember(user.getId())) {
-                totalMembers++;
-                if (memberManager->isVIPMember(user.getId())) {
-                    vipMembers++;
-                }
-            }
-        }
+    // Reports come from running totals per class, so these are lookups
+    snapshot.currentReport = classManager->generateMonthlyReport(monthStart);
+    snapshot.previousReport = classManager->generateMonthlyReport(previousMonthStart);
 
-        // Update UI with validated data
-        int vipPercentage = totalMembers > 0 ? (vipMembers * 100) / totalMembers : 0;
-        updateMetrics(membershipLabel, membershipBar,
-            QString("Members: %1\nVIP: %2%").arg(totalMembers).arg(vipPercentage),
-            qBound(0, vipPercentage, 100));
-
-        int attendanceRate = currentReport.totalClassesHeld > 0 ? 
-            (currentReport.totalAttendance * 100) / (currentReport.totalClassesHeld * 30) : 0;
-        updateMetrics(classLabel, classBar,
-            QString("Classes: %1\nRevenue: $%2")
-                .arg(currentReport.totalClassesHeld)
-                .arg(currentReport.totalRevenue, 0, 'f', 2),
-            qBound(0, attendanceRate, 100));
-
-        int activeRate = totalMembers > 0 ? 
-            (currentReport.totalActiveMembers * 100) / totalMembers : 0;
-        updateMetrics(courtLabel, courtBar,
-            QString("Active Members: %1\nRevenue/Member: $%2")
-                .arg(currentReport.totalActiveMembers)
-                .arg(totalMembers > 0 ? currentReport.totalRevenue / totalMembers : 0, 0, 'f', 2),
-            qBound(0, activeRate, 100));
+    figuresWatcher.setFuture(QtConcurrent::run([snapshot = std::move(snapshot)]() {
+        return computeFigures(snapshot);
+    }));
+}
 
-        // Calculate growth
-        QVector<MonthlyReport> previousMonthReports = classManager->getMonthlyReports(
-            previousMonthStart, monthStart.addDays(-1));
-        
-        double revenueGrowth = 0;
-        int memberGrowth = 0;
-        
-        if (!previousMonthReports.isEmpty()) {
-            const MonthlyReport& prevReport = previousMonthReports.first();
-            if (prevReport.totalRevenue > 0) {
-                revenueGrowth = ((currentReport.totalRevenue - prevReport.totalRevenue) * 100) 
-                               / prevReport.totalRevenue;
-            }
-            if (prevReport.totalActiveMembers > 0) {
-                memberGrowth = ((currentReport.totalActiveMembers - prevReport.totalActiveMembers) * 100) 
-                              / prevReport.totalActiveMembers;
-            }
-        }
+void Revenue::applyFigures(const RevenueFigures& figures)
+{
+    updateMetrics(membershipLabel, membershipBar,
+        QString("Members: %1\nVIP: %2%").arg(figures.totalMembers).arg(figures.vipPercentage),
+        qBound(0, figures.vipPercentage, 100));
 
-        updateMetrics(growthLabel, growthBar,
-            QString("Revenue Growth: %1%\nMember Growth: %2%")
-                .arg(revenueGrowth, 0, 'f', 1)
-                .arg(memberGrowth),
-            qBound(0, static_cast<int>(revenueGrowth), 100));
-
-
-        //PADEL COURTS DATA
-        if (padelManager) {
-            int totalCourts = padelManager->getAllCourts().size();
-            int bookedCourts = padelManager->getBookedCourtsCount();
-            int courtUtilization = totalCourts > 0 ? (bookedCourts * 100) / totalCourts : 0;
-            
-            // Calculate VIP booking rate
-            int totalBookings = 0;
-            int vipBookings = 0;
-            QVector<Booking> allBookings = padelManager->getAllBookings();
-            for (const Booking& booking : allBookings) {
-                if (!booking.isCancelled()) {
-                    totalBookings++;
-                    if (booking.isVip()) {
-                        vipBookings++;
-                    }
-                }
-            }
-            int vipBookingRate = totalBookings > 0 ? (vipBookings * 100) / totalBookings : 0;
-            
-            updateMetrics(courtLabel, courtBar,
-                QString("Court Utilization: %1%\nVIP Bookings: %2%")
-                    .arg(courtUtilization)
-                    .arg(vipBookingRate),
-                courtUtilization);
-        }
+    updateMetrics(classLabel, classBar,
+        QString("Classes: %1\nRevenue: $%2")
+            .arg(figures.classesHeld)
+            .arg(figures.classRevenue, 0, 'f', 2),
+        qBound(0, figures.attendanceRate, 100));
 
-    } catch (const std::exception& e) {
-        qDebug() << "Error updating revenue data:" << e.what();
+    if (figures.hasCourtData) {
+        updateMetrics(courtLabel, courtBar,
+            QString("Court Utilization: %1%\nVIP Bookings: %2%")
+                .arg(figures.courtUtilization)
+                .arg(figures.vipBookingRate),
+            figures.courtUtilization);
+    } else {
+        updateMetrics(courtLabel, courtBar,
+            QString("Active Members: %1\nRevenue/Member: $%2")
+                .arg(figures.activeMembers)
+                .arg(figures.revenuePerMember, 0, 'f', 2),
+            qBound(0, figures.activeRate, 100));
     }
+
+    updateMetrics(growthLabel, growthBar,
+        QString("Revenue Growth: %1%\nMember Growth: %2%")
+            .arg(figures.revenueGrowth, 0, 'f', 1)
+            .arg(figures.memberGrowth),
+        qBound(0, static_cast<int>(figures.revenueGrowth), 100));
 }
 
 void Revenue::updateTheme(bool isDark)
@@ -2,6 +2,8 @@
 #define REVENUE_H
 
 #include <QWidget>
+#include <QTimer>
+#include <QFutureWatcher>
 class QLabel;
 class QProgressBar;
 class UserDataManager;
@@ -9,6 +11,23 @@ class MemberDataManager;
 class ClassDataManager;
 class PadelDataManager;
 
+// Figures shown by the widget, computed off the GUI thread
+struct RevenueFigures {
+    int totalMembers{0};
+    int vipPercentage{0};
+    int classesHeld{0};
+    double classRevenue{0.0};
+    int attendanceRate{0};
+    int activeMembers{0};
+    int activeRate{0};
+    double revenuePerMember{0.0};
+    double revenueGrowth{0.0};
+    int memberGrowth{0};
+    bool hasCourtData{false};
+    int courtUtilization{0};
+    int vipBookingRate{0};
+};
+
 class Revenue : public QWidget
 {
     Q_OBJECT
@@ -16,7 +35,10 @@ class Revenue : public QWidget
 public:
     explicit Revenue(UserDataManager* userDataManager, MemberDataManager* memberDataManager,
                     ClassDataManager* classDataManager, QWidget* parent = nullptr);
+    ~Revenue() override;
     void updateTheme(bool isDark);
+    // Requests a refresh; bursts of requests are coalesced and the figures are
+    // aggregated on a worker thread, so this returns immediately
     void updateData();
 
     // Data manager setters
@@ -34,6 +56,8 @@ public:
 private:
     void updateMetrics(QLabel* label, QProgressBar* bar, const QString& text, int value);
     void setupUI();
+    void startRefresh();
+    void applyFigures(const RevenueFigures& figures);
 
     bool isDarkTheme;
     UserDataManager* userManager;
@@ -51,6 +75,13 @@ private:
     QProgressBar* courtBar;
     QProgressBar* growthBar;
 
+    // Refresh pipeline: refreshTimer debounces updateData(), figuresWatcher tracks the
+    // running aggregation and refreshPending asks for one more pass once it is done
+    QTimer refreshTimer;
+    QFutureWatcher<RevenueFigures> figuresWatcher;
+    bool refreshPending{false};
+    static constexpr int RefreshDebounceMs = 200;
+
     // Analytics data structure
     struct {
         int vipMemberPercentage{0};
@@ -9,6 +9,9 @@
 #include "../DataManager/memberdatamanager.h"
 #include "../DataManager/classdatamanager.h"
 #include "../DataManager/padeldatamanager.h"
+#include "../DataManager/binarysnapshot.h"
+#include "../DataManager/passwordhasher.h"
+#include "../DataManager/memberimporter.h"
 #include "../Language/LanguageManager.h"
 #include "../Model/System/timeLogic.h"
 #include <QSettings>
@@ -19,6 +22,7 @@
 #include "../src/pages/Gym/staffhomepage.h"
 #include <QDebug>
 #include <QTimer>
+#include <QElapsedTimer>
 
 int main(int argc, char* argv[])
 {
@@ -29,6 +33,59 @@ int main(int argc, char* argv[])
     QSettings::setDefaultFormat(QSettings::IniFormat);
     QSettings settings;
 
+    // Offline conversion between a JSON data file and its binary snapshot
+    const QStringList arguments = QApplication::arguments();
+    const int convertIndex = arguments.indexOf("--convert-snapshot");
+    if (convertIndex >= 0 && convertIndex + 1 < arguments.size()) {
+        const QString path = arguments.at(convertIndex + 1);
+        QString errorMessage;
+        const bool converted = path.endsWith(".bin")
+            ? BinarySnapshot::convertBinaryToJson(path, errorMessage)
+            : BinarySnapshot::convertJsonToBinary(path, errorMessage);
+        if (!converted) {
+            qWarning() << "Snapshot conversion failed:" << errorMessage;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Verify latency per password hash cost, to pick security/passwordCost for this machine
+    const int benchmarkIndex = arguments.indexOf("--benchmark-password-hash");
+    if (benchmarkIndex >= 0) {
+        const int rounds = benchmarkIndex + 1 < arguments.size() ? arguments.at(benchmarkIndex + 1).toInt() : 0;
+        PasswordHasher::runBenchmark(PasswordHasher::MinCost, PasswordHasher::MaxCost, rounds > 0 ? rounds : 5);
+        return 0;
+    }
+
+    // Bulk import of users and members from CSV or JSON, e.g. a partner gym's member list
+    const int importIndex = arguments.indexOf("--import-members");
+    if (importIndex >= 0 && importIndex + 1 < arguments.size()) {
+        UserDataManager userDataManager;
+        MemberDataManager memberDataManager;
+        memberDataManager.setUserDataManager(&userDataManager);
+
+        std::vector<MemberImporter::Row> rows;
+        QString errorMessage;
+        if (!MemberImporter::readFile(arguments.at(importIndex + 1), rows, errorMessage)) {
+            qWarning() << "Member import failed:" << errorMessage;
+            return 1;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        const MemberImporter::Report report = MemberImporter::import(rows, userDataManager, memberDataManager);
+        for (const MemberImporter::RowError& error : report.errors) {
+            qWarning().noquote() << QString("Row %1: %2").arg(error.source).arg(error.message);
+        }
+        qInfo().noquote() << QString("Imported %1 of %2 members in %3 ms")
+                                 .arg(report.imported).arg(rows.size()).arg(timer.elapsed());
+        if (!report.saveError.isEmpty()) {
+            qWarning() << "Member import failed:" << report.saveError;
+            return 1;
+        }
+        return report.errors.isEmpty() ? 0 : 1;
+    }
+
     auto& languageManager = LanguageManager::getInstance();
     languageManager.setLanguage("en");
     QString savedLanguage = settings.value("language").toString();
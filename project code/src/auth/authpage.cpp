@@ -53,10 +53,10 @@ AuthPage::AuthPage(UserDataManager* userDataManager, QWidget* parent)
     connect(&LanguageManager::getInstance(), &LanguageManager::languageChanged,
             this, &AuthPage::retranslateUI);
 
-    QString rememberedEmail, rememberedPassword;
-    if (userDataManager->getRememberedCredentials(rememberedEmail, rememberedPassword)) {
+    QString rememberedEmail, rememberedToken;
+    if (userDataManager->getRememberedCredentials(rememberedEmail, rememberedToken)) {
         loginEmailInput->setText(rememberedEmail);
-        loginPasswordInput->setText(rememberedPassword);
+        loginPasswordInput->setText(rememberedToken);
         rememberMeCheckbox->setChecked(true);
     }
 }
@@ -878,15 +878,42 @@ void AuthPage::handleLogin()
             return;
         }
 
-        // Then validate password
-        if (!userDataManager->validateUser(email, password)) {
-            showError(tr("Incorrect password. Please try again."));
+        if (loginInProgress) {
             return;
         }
 
+        // Then validate password; the hash is deliberately slow, so it runs off the GUI thread
+        loginInProgress = true;
+        if (loginButton) {
+            loginButton->setEnabled(false);
+        }
+        userDataManager->validateUserAsync(email, password, this, [this, email](bool valid) {
+            loginInProgress = false;
+            if (loginButton) {
+                loginButton->setEnabled(true);
+            }
+
+            if (!valid) {
+                showError(tr("Incorrect password. Please try again."));
+                return;
+            }
+            completeLogin(email);
+        });
+    } catch (const std::exception& e) {
+        qDebug() << "Exception in handleLogin: " << e.what();
+        showError(tr("An error occurred during login. Please try again."));
+    } catch (...) {
+        qDebug() << "Unknown exception in handleLogin";
+        showError(tr("An unexpected error occurred. Please try again."));
+    }
+}
+
+void AuthPage::completeLogin(const QString& email)
+{
+    try {
         // Handle successful login
         if (rememberMeCheckbox && rememberMeCheckbox->isChecked()) {
-            userDataManager->saveRememberedCredentials(email, password);
+            userDataManager->saveRememberedCredentials(email);
         } else if (rememberMeCheckbox && !rememberMeCheckbox->isChecked()) {
             // Show confirmation dialog before clearing remembered credentials
             showConfirmationDialog(
@@ -920,10 +947,10 @@ void AuthPage::handleLogin()
         });
         delayTimer->start(1500);
     } catch (const std::exception& e) {
-        qDebug() << "Exception in handleLogin: " << e.what();
+        qDebug() << "Exception in completeLogin: " << e.what();
         showError(tr("An error occurred during login. Please try again."));
     } catch (...) {
-        qDebug() << "Unknown exception in handleLogin";
+        qDebug() << "Unknown exception in completeLogin";
         showError(tr("An unexpected error occurred. Please try again."));
     }
 }
@@ -2064,10 +2091,10 @@ void AuthPage::showEvent(QShowEvent* event)
 {
     QMainWindow::showEvent(event);
     clearFields();
-    QString rememberedEmail, rememberedPassword;
-    if (userDataManager->getRememberedCredentials(rememberedEmail, rememberedPassword)) {
+    QString rememberedEmail, rememberedToken;
+    if (userDataManager->getRememberedCredentials(rememberedEmail, rememberedToken)) {
         loginEmailInput->setText(rememberedEmail);
-        loginPasswordInput->setText(rememberedPassword);
+        loginPasswordInput->setText(rememberedToken);
         rememberMeCheckbox->setChecked(true);
     }
 }
@@ -81,6 +81,7 @@ private:
     void animateMessageWidget(bool isError) const;
     void showConfirmationDialog(const QString& title, const QString& message,
         const QString& confirmText, const QString& cancelText, std::function<void()> onConfirm);
+    void completeLogin(const QString& email);
 
     UserDataManager* userDataManager;
     QStackedWidget* stackedWidget{};
@@ -91,6 +92,7 @@ private:
     CustomLineEdit* loginPasswordInput{};
     QPushButton* loginButton{};
     QCheckBox* rememberMeCheckbox{};
+    bool loginInProgress = false;  // A password check is running on a worker thread
     QPushButton* forgotPasswordButton{};
 
     CustomLineEdit* signupNameInput{};
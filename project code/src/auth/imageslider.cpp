@@ -5,12 +5,15 @@
 #include <QGraphicsOpacityEffect>
 #include <QPropertyAnimation>
 #include <QParallelAnimationGroup>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
 
 #include "LanguageManager.h"
 
 ImageSlider::ImageSlider(QWidget* parent)
     : QWidget(parent)
     , currentIndex(0)
+    , nextIndex(-1)
     , m_slideOffset(0.0)
     , isDarkTheme(false)
     , isSlidingLeft(true)
@@ -59,6 +62,9 @@ void ImageSlider::retranslateUI()
         tr("Join Our Community"),
         tr("Connect with like-minded fitness enthusiasts and reach your goals together"));
 
+    // The cached text layer still shows the old language
+    overlayIndex = -1;
+
     // Force repaint to show new translations
     update();
 }
@@ -140,23 +146,108 @@ void ImageSlider::addSlide(const QString& imagePath, const QString& title, const
     slides.push_back({imagePath, title, description});
     
     if (slides.size() == 1) {
-        // Load image from resource system
-        currentImage = QPixmap(imagePath);
-        if (currentImage.isNull()) {
-            qWarning() << "Failed to load image:" << imagePath;
-            // If the path doesn't start with :/, try adding it
-            if (!imagePath.startsWith(":/")) {
-                currentImage = QPixmap(":/" + imagePath);
-                if (currentImage.isNull()) {
-                    qWarning() << "Failed to load image from resource:" << ":/" + imagePath;
-                }
+        update();
+    }
+}
+
+QImage ImageSlider::loadSlideImage(const QString& imagePath)
+{
+    // Load image from resource system
+    QImage image(imagePath);
+    if (image.isNull()) {
+        qWarning() << "Failed to load image:" << imagePath;
+        // If the path doesn't start with :/, try adding it
+        if (!imagePath.startsWith(":/")) {
+            image = QImage(":/" + imagePath);
+            if (image.isNull()) {
+                qWarning() << "Failed to load image from resource:" << ":/" + imagePath;
             }
         }
-        if (!currentImage.isNull()) {
-            originalSize = currentImage.size();
-        }
-        update();
     }
+    return image;
+}
+
+QImage ImageSlider::scaleToCover(const QImage& image, const QSize& targetSize)
+{
+    if (image.isNull() || targetSize.isEmpty()) {
+        return QImage();
+    }
+    return image.scaled(targetSize, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+}
+
+QPixmap ImageSlider::frameFor(int index)
+{
+    if (index < 0 || index >= static_cast<int>(slides.size()) || size().isEmpty()) {
+        return QPixmap();
+    }
+
+    auto it = scaledFrames.constFind(index);
+    if (it != scaledFrames.constEnd()) {
+        return it.value();
+    }
+
+    // Not prescaled yet (first paint or just resized): scale once and keep it
+    const qreal ratio = devicePixelRatioF();
+    QPixmap frame = QPixmap::fromImage(scaleToCover(loadSlideImage(slides[index].imagePath), size() * ratio));
+    frame.setDevicePixelRatio(ratio);
+    scaledFrames.insert(index, frame);
+    return frame;
+}
+
+void ImageSlider::prescaleSlide(int index)
+{
+    if (index < 0 || index >= static_cast<int>(slides.size()) || size().isEmpty() ||
+        scaledFrames.contains(index) || pendingFrames.contains(index)) {
+        return;
+    }
+
+    pendingFrames.insert(index);
+
+    const int generation = frameGeneration;
+    const qreal ratio = devicePixelRatioF();
+    const QSize targetSize = size() * ratio;
+    const QString imagePath = slides[index].imagePath;
+
+    // Decoding and smooth scaling run on a worker; only QImage crosses threads
+    auto* watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, index, generation, ratio]() {
+        if (generation == frameGeneration) {
+            pendingFrames.remove(index);
+            const QImage scaled = watcher->result();
+            if (!scaled.isNull() && !scaledFrames.contains(index)) {
+                QPixmap frame = QPixmap::fromImage(scaled);
+                frame.setDevicePixelRatio(ratio);
+                scaledFrames.insert(index, frame);
+            }
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([imagePath, targetSize]() {
+        return scaleToCover(loadSlideImage(imagePath), targetSize);
+    }));
+}
+
+QPixmap ImageSlider::renderOverlayLayer() const
+{
+    const qreal ratio = devicePixelRatioF();
+    QPixmap layer(size() * ratio);
+    layer.setDevicePixelRatio(ratio);
+    layer.fill(Qt::transparent);
+
+    QPainter layerPainter(&layer);
+    layerPainter.setRenderHint(QPainter::Antialiasing);
+    applyImageOverlay(layerPainter);
+    drawSlideText(layerPainter);
+    return layer;
+}
+
+void ImageSlider::invalidateFrames()
+{
+    scaledFrames.clear();
+    pendingFrames.clear();
+    overlayLayer = QPixmap();
+    overlayIndex = -1;
+    ++frameGeneration;
 }
 
 void ImageSlider::goToSlide(int index)
@@ -164,26 +255,20 @@ void ImageSlider::goToSlide(int index)
     if (index == currentIndex || index < 0 || index >= static_cast<int>(slides.size()))
         return;
     
-    // Load image from resource system
-    nextImage = QPixmap(slides[index].imagePath);
-    if (nextImage.isNull()) {
-        qWarning() << "Failed to load image:" << slides[index].imagePath;
-        // Try loading with resource path
-        nextImage = QPixmap(":/" + slides[index].imagePath);
-        if (nextImage.isNull()) {
-            qWarning() << "Failed to load image from resource:" << ":/" + slides[index].imagePath;
-            return;
-        }
+    if (frameFor(index).isNull()) {
+        return;
     }
     
+    nextIndex = index;
     m_slideOffset = 0.0;
     slideAnimation->start();
     
     connect(slideAnimation, &QPropertyAnimation::finished, this, [this, index]() {
         currentIndex = index;
-        currentImage = nextImage;
+        nextIndex = -1;
         m_slideOffset = 0.0;
         update();
+        prescaleSlide((currentIndex + 1) % static_cast<int>(slides.size()));
     }, Qt::SingleShotConnection);
 }
 
@@ -191,6 +276,8 @@ void ImageSlider::resizeEvent(QResizeEvent* event)
 {
     QWidget::resizeEvent(event);
 
+    invalidateFrames();
+
     const int buttonSize = prevButton->width();
     const int verticalCenter = height() / 2 - buttonSize / 2;
     
@@ -212,53 +299,51 @@ void ImageSlider::paintEvent(QPaintEvent* event)
     QWidget::paintEvent(event);
     
     QPainter painter(this);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform);
-    painter.setRenderHint(QPainter::Antialiasing);
     
-    if (!currentImage.isNull()) {
-        painter.setClipRect(rect());
-        
-        QSize scaledSize = currentImage.size();
-        scaledSize.scale(size(), Qt::KeepAspectRatioByExpanding);
-        
-        int x = (width() - scaledSize.width()) / 2;
-        int y = (height() - scaledSize.height()) / 2;
+    // Frames are already at widget size, so this is blitting only
+    auto drawFrame = [this, &painter](const QPixmap& frame, int offset) {
+        const QSize frameSize = frame.deviceIndependentSize().toSize();
+        int x = (width() - frameSize.width()) / 2;
+        int y = (height() - frameSize.height()) / 2;
         
         if (x > 0) x = 0;
         if (y > 0) y = 0;
         
-        int offset = static_cast<int>(width() * m_slideOffset);
-        if (!isSlidingLeft) {
-            offset = -offset;
-        }
-        
-        painter.drawPixmap(x + offset, y, 
-            currentImage.scaled(scaledSize, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation));
-        
-        applyImageOverlay(painter);
-        drawSlideText(painter);
+        painter.drawPixmap(x + offset, y, frame);
+    };
+    
+    const QPixmap currentFrame = frameFor(currentIndex);
+    if (currentFrame.isNull()) {
+        return;
     }
     
-    if (!nextImage.isNull() && m_slideOffset > 0.0) {
-        QSize nextScaledSize = nextImage.size();
-        nextScaledSize.scale(size(), Qt::KeepAspectRatioByExpanding);
-        
-        int x = (width() - nextScaledSize.width()) / 2;
-        int y = (height() - nextScaledSize.height()) / 2;
-        
-        if (x > 0) x = 0;
-        if (y > 0) y = 0;
-        
-        int offset = static_cast<int>(width() * (1.0 - m_slideOffset));
-        if (isSlidingLeft) {
-            offset = -offset;
+    if (overlayIndex != currentIndex || overlayLayer.isNull()) {
+        overlayLayer = renderOverlayLayer();
+        overlayIndex = currentIndex;
+    }
+    
+    painter.setClipRect(rect());
+    
+    int offset = static_cast<int>(width() * m_slideOffset);
+    if (!isSlidingLeft) {
+        offset = -offset;
+    }
+    drawFrame(currentFrame, offset);
+    painter.drawPixmap(0, 0, overlayLayer);
+    
+    if (nextIndex >= 0 && m_slideOffset > 0.0) {
+        const QPixmap nextFrame = frameFor(nextIndex);
+        if (!nextFrame.isNull()) {
+            int nextOffset = static_cast<int>(width() * (1.0 - m_slideOffset));
+            if (isSlidingLeft) {
+                nextOffset = -nextOffset;
+            }
+            drawFrame(nextFrame, nextOffset);
+            painter.drawPixmap(0, 0, overlayLayer);
         }
-        
-        painter.drawPixmap(x + offset, y, 
-            nextImage.scaled(nextScaledSize, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation));
-        
-        applyImageOverlay(painter);
-        drawSlideText(painter);
+    } else if (!slides.empty()) {
+        // Have the slide after this one ready before the next transition starts
+        prescaleSlide((currentIndex + 1) % static_cast<int>(slides.size()));
     }
 }
 
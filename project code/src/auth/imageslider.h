@@ -6,6 +6,10 @@
 #include <QPropertyAnimation>
 #include <QPushButton>
 #include <QLabel>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
 #include <vector>
 
 struct SlideInfo {
@@ -57,9 +61,7 @@ private:
 
     std::vector<Slide> slides;
     int currentIndex;
-    QPixmap currentImage;
-    QPixmap nextImage;
-    QSize originalSize;
+    int nextIndex;
     double m_slideOffset;
     QTimer* autoSlideTimer;
     QPropertyAnimation* slideAnimation;
@@ -68,8 +70,23 @@ private:
     bool isDarkTheme;
     bool isSlidingLeft;
 
+    // Slide images scaled to the current widget size, keyed by slide index, and the
+    // gradient + text layer of the current slide. Animation frames only blit these.
+    // Everything is dropped in resizeEvent(); frameGeneration tells background scaling
+    // jobs started before a resize that their result is stale.
+    QHash<int, QPixmap> scaledFrames;
+    QSet<int> pendingFrames;
+    QPixmap overlayLayer;
+    int overlayIndex{-1};
+    int frameGeneration{0};
+
     void setupUI();
-    void loadImages();
+    QPixmap frameFor(int index);
+    void prescaleSlide(int index);
+    QPixmap renderOverlayLayer() const;
+    void invalidateFrames();
+    static QImage loadSlideImage(const QString& imagePath);
+    static QImage scaleToCover(const QImage& image, const QSize& targetSize);
     void applyImageOverlay(QPainter& painter) const;
     void drawSlideText(QPainter& painter) const;
     QString getNavigationButtonStyle() const;
@@ -6,6 +6,7 @@
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QScrollArea>
+#include <QHash>
 
 #include "Stylesheets/Padel/BookingWindowStyle.h"
 
@@ -1427,6 +1428,10 @@ void BookingWindow::refreshTimeSlots() {
     int courtId = m_courtSelector->currentData().toInt();
     if (courtId <= 0) return;
 
+    const WeekOccupancy occupancy = m_padelManager->getWeekOccupancy(courtId, sundayDate, m_currentUserId,
+                                                                     QTime(7, 0), 15);
+    const int maxAttendees = occupancy.maxAttendees;
+
     for (int day = 0; day < 7; day++) {
         QDate currentDate = sundayDate.addDays(day);
         bool isSelectedDay = (currentDate == selectedDate);
@@ -1449,25 +1454,11 @@ void BookingWindow::refreshTimeSlots() {
             QDateTime startDateTime(currentDate, startTime);
             QDateTime endDateTime(currentDate, endTime);
 
-            bool isBookedByUser = false;
-            bool isFullyBooked = false;
-            int bookingId = -1;
-            int currentAttendees = 0;
-            int maxAttendees = m_padelManager->getCourtById(courtId).getMaxAttendees();
-            QVector<Booking> slotBookings = m_padelManager->getBookingsForTimeSlot(courtId, startDateTime, endDateTime);
-            
-            // Count valid (non-cancelled) bookings
-            for (const Booking& booking : slotBookings) {
-                if (!booking.isCancelled()) {
-                    currentAttendees++;
-                    if (booking.getUserId() == m_currentUserId) {
-                        isBookedByUser = true;
-                        bookingId = booking.getBookingId();
-                    }
-                }
-            }    
-
-            isFullyBooked = (currentAttendees >= maxAttendees);
+            const SlotOccupancy& slot = occupancy.at(day, timeSlot);
+            bool isBookedByUser = slot.isBookedByUser;
+            int bookingId = slot.userBookingId;
+            int currentAttendees = slot.attendees;
+            bool isFullyBooked = (currentAttendees >= maxAttendees);
             
             // First disconnect any existing connections to prevent signal/slot issues
             cellButton->disconnect();
@@ -1815,12 +1806,19 @@ void BookingWindow::refreshBookingsList()
     }
     
     QVector<Booking> bookings = m_padelManager->getBookingsByMember(m_currentUserId);
+    QHash<int, QString> courtNames;
     
     for (const Booking& booking : bookings) {
         if (!booking.isCancelled()) {
+            auto nameIt = courtNames.find(booking.getCourtId());
+            if (nameIt == courtNames.end()) {
+                nameIt = courtNames.insert(booking.getCourtId(),
+                                           m_padelManager->getCourtById(booking.getCourtId()).getName());
+            }
+
             QString bookingInfo = tr("Booking #%1: Court %2 on %3 from %4 to %5")
                                  .arg(booking.getBookingId())
-                                 .arg(booking.getCourt().getName())
+                                 .arg(nameIt.value())
                                  .arg(booking.getStartTime().date().toString("yyyy-MM-dd"))
                                  .arg(booking.getStartTime().time().toString("HH:mm"))
                                  .arg(booking.getEndTime().time().toString("HH:mm"));
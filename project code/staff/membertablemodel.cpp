@@ -0,0 +1,195 @@
+#include "membertablemodel.h"
+#include <algorithm>
+
+MemberTableModel::MemberTableModel(UserDataManager* userDataManager, MemberDataManager* memberManager, QObject* parent)
+    : QAbstractTableModel(parent), userDataManager(userDataManager), memberManager(memberManager)
+{
+    memberIds = matchingMemberIds();
+
+    connect(memberManager, &MemberDataManager::memberCreated, this, &MemberTableModel::refresh);
+    connect(memberManager, &MemberDataManager::memberUpdated, this, &MemberTableModel::refresh);
+    connect(memberManager, &MemberDataManager::membersImported, this, &MemberTableModel::refresh);
+}
+
+int MemberTableModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    // An empty result still shows one "No data" row
+    return memberIds.isEmpty() ? 1 : memberIds.size();
+}
+
+int MemberTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant MemberTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid()) {
+        return QVariant();
+    }
+
+    if (role == Qt::TextAlignmentRole) {
+        return QVariant::fromValue(Qt::Alignment(Qt::AlignCenter));
+    }
+
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    if (memberIds.isEmpty()) {
+        return index.column() == NameColumn ? tr("No data") : QStringLiteral("-");
+    }
+
+    const int memberId = memberIds.value(index.row());
+    switch (index.column()) {
+    case IdColumn:
+        return QString::number(memberId);
+    case NameColumn:
+        return rowText(memberId).name;
+    case EmailColumn:
+        return rowText(memberId).email;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant MemberTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case IdColumn:
+        return tr("ID");
+    case NameColumn:
+        return tr("Name");
+    case EmailColumn:
+        return tr("Email");
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags MemberTableModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid() || memberIds.isEmpty()) {
+        return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+void MemberTableModel::setFilter(const QString& filter)
+{
+    if (filter == currentFilter) {
+        return;
+    }
+
+    currentFilter = filter;
+    applyMemberIds(matchingMemberIds());
+}
+
+void MemberTableModel::refresh()
+{
+    textCache.clear();
+    applyMemberIds(matchingMemberIds());
+
+    if (!memberIds.isEmpty()) {
+        emit dataChanged(index(0, 0), index(memberIds.size() - 1, ColumnCount - 1), {Qt::DisplayRole});
+    }
+}
+
+int MemberTableModel::memberIdAt(int row) const
+{
+    return memberIds.value(row, 0);
+}
+
+QVector<int> MemberTableModel::matchingMemberIds() const
+{
+    if (currentFilter.trimmed().isEmpty()) {
+        return memberManager->getAllMemberIds();
+    }
+    return memberManager->findMemberIds(currentFilter);
+}
+
+void MemberTableModel::applyMemberIds(const QVector<int>& newIds)
+{
+    // The placeholder row does not map onto ids, so the list must never pass through
+    // empty on the incremental path; huge churn is also cheaper as a reset
+    int runs = 0;
+    int common = 0;
+    if (!memberIds.isEmpty() && !newIds.isEmpty()) {
+        int i = 0, j = 0;
+        bool inRun = false;
+        while ((i < memberIds.size() || j < newIds.size()) && runs <= MaxIncrementalRuns) {
+            const bool same = i < memberIds.size() && j < newIds.size() && memberIds[i] == newIds[j];
+            if (same) {
+                ++i;
+                ++j;
+                ++common;
+            } else if (j == newIds.size() || (i < memberIds.size() && memberIds[i] < newIds[j])) {
+                ++i;
+            } else {
+                ++j;
+            }
+            if (!same && !inRun) {
+                ++runs;
+            }
+            inRun = !same;
+        }
+    }
+
+    if (common == 0 || runs > MaxIncrementalRuns) {
+        beginResetModel();
+        memberIds = newIds;
+        endResetModel();
+        return;
+    }
+
+    // Both lists are ascending: walk them together, dropping and adding rows in runs
+    int row = 0;
+    int j = 0;
+    while (row < memberIds.size() || j < newIds.size()) {
+        if (row < memberIds.size() && j < newIds.size() && memberIds[row] == newIds[j]) {
+            ++row;
+            ++j;
+            continue;
+        }
+
+        if (j == newIds.size() || (row < memberIds.size() && memberIds[row] < newIds[j])) {
+            int last = row;
+            while (last + 1 < memberIds.size() && (j == newIds.size() || memberIds[last + 1] < newIds[j])) {
+                ++last;
+            }
+            beginRemoveRows(QModelIndex(), row, last);
+            memberIds.remove(row, last - row + 1);
+            endRemoveRows();
+        } else {
+            int count = 1;
+            while (j + count < newIds.size() && (row == memberIds.size() || newIds[j + count] < memberIds[row])) {
+                ++count;
+            }
+            beginInsertRows(QModelIndex(), row, row + count - 1);
+            memberIds.insert(row, count, 0);
+            std::copy(newIds.begin() + j, newIds.begin() + j + count, memberIds.begin() + row);
+            endInsertRows();
+            row += count;
+            j += count;
+        }
+    }
+}
+
+const MemberTableModel::RowText& MemberTableModel::rowText(int memberId) const
+{
+    auto it = textCache.find(memberId);
+    if (it != textCache.end()) {
+        return it->second;
+    }
+
+    const Member member = memberManager->getMemberById(memberId);
+    const User user = userDataManager->getUserDataById(member.getUserId());
+    return textCache.emplace(memberId, RowText{user.getName(), user.getEmail()}).first->second;
+}
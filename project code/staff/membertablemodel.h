@@ -0,0 +1,60 @@
+#ifndef MEMBERTABLEMODEL_H
+#define MEMBERTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <QVector>
+#include <unordered_map>
+#include "UserDataManager.h"
+#include "MemberDataManager.h"
+
+// Member id, name and email for the staff member table.
+//
+// The model only holds the ids that pass the current filter; names and emails are
+// looked up when the view asks for a row and remembered until the next refresh, so
+// only rows that are actually painted are ever materialized. Changing the filter
+// removes and inserts rows in runs against the previous id list instead of
+// rebuilding the table.
+class MemberTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column { IdColumn, NameColumn, EmailColumn, ColumnCount };
+
+    MemberTableModel(UserDataManager* userDataManager, MemberDataManager* memberManager, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    void setFilter(const QString& filter);
+    // Re-reads the member list, e.g. after members were added or changed
+    void refresh();
+
+    // 0 for the "No data" placeholder row
+    int memberIdAt(int row) const;
+
+private:
+    struct RowText {
+        QString name;
+        QString email;
+    };
+
+    QVector<int> matchingMemberIds() const;
+    void applyMemberIds(const QVector<int>& newIds);
+    const RowText& rowText(int memberId) const;
+
+    UserDataManager* userDataManager;
+    MemberDataManager* memberManager;
+    QString currentFilter;
+    QVector<int> memberIds;                                 // Ascending
+    mutable std::unordered_map<int, RowText> textCache;     // memberId -> looked-up text
+
+    // Beyond this many changed runs a reset is cheaper than granular row signals
+    static constexpr int MaxIncrementalRuns = 64;
+};
+
+#endif // MEMBERTABLEMODEL_H
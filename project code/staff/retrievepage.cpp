@@ -5,17 +5,16 @@
 #include <QPropertyAnimation>
 #include <QGraphicsOpacityEffect>
 #include <QTimer>
-#include <QTableWidget>
+#include <QTableView>
 #include <QVector>
 #include <QHeaderView>
 #include <QDebug>
 #include <QLineEdit>
 #include <QFormLayout>
-#include <QTableWidget>
 #include <QMessageBox>
 #include <QPushButton>
 RetrievePage::RetrievePage(UserDataManager *userDataManager, MemberDataManager *memberManager, QWidget *parent)
-    : QWidget(parent), userDataManager(userDataManager), memberManager(memberManager), mainLayout(nullptr), leftSidebar(nullptr), contentStack(nullptr), customContent(nullptr), isDarkTheme(false), currentUserId(0), searchEdit(nullptr), tableWidget(nullptr)
+    : QWidget(parent), userDataManager(userDataManager), memberManager(memberManager), mainLayout(nullptr), leftSidebar(nullptr), contentStack(nullptr), customContent(nullptr), isDarkTheme(false), currentUserId(0), searchEdit(nullptr), tableView(nullptr), memberModel(nullptr)
 {
     setupUI();
 }
@@ -73,18 +72,21 @@ void RetrievePage::setupUI()
     cardLayout->addWidget(searchEdit);
 
     // Table setup
-    tableWidget = new QTableWidget;
-    tableWidget->setObjectName("dataTable");
-    tableWidget->setMinimumSize(400, 200);
-    tableWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
-    tableWidget->setColumnCount(3);
-    tableWidget->setHorizontalHeaderLabels({tr("ID"), tr("Name"), tr("Email")});
-    tableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    tableWidget->verticalHeader()->setVisible(false);
-    tableWidget->setShowGrid(true);
-    tableWidget->setStyleSheet(QString(R"(        QTableWidget {            background: %4;            color: %1;            font-size: 16px;            border: none;            gridline-color: %2;        }        QTableWidget::item {            padding: 8px;            color: %1;            background: %4;        }        QTableWidget::item:selected {            background: %5;            color: %1;        }        QHeaderView::section {            background: %3;            color: %1;            padding: 8px;            border: none;        }    )").arg(isDarkTheme ? "#F9FAFB" : "#111827", /* Text color */ isDarkTheme ? "#4B5563" : "#D1D5DB", /* Grid color */ isDarkTheme ? "rgba(55, 65, 81, 0.95)" : "rgba(229, 231, 235, 0.95)", /* Header background */ isDarkTheme ? "rgba(31, 41, 55, 0.5)" : "rgba(255, 255, 255, 0.8)", /* Cell background */ isDarkTheme ? "rgba(139, 92, 246, 0.2)" : "rgba(139, 92, 246, 0.1)" /* Selection background */));
-
-    cardLayout->addWidget(tableWidget);
+    memberModel = new MemberTableModel(userDataManager, memberManager, this);
+    tableView = new QTableView;
+    tableView->setObjectName("dataTable");
+    tableView->setModel(memberModel);
+    tableView->setMinimumSize(400, 200);
+    tableView->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+    tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    tableView->verticalHeader()->setVisible(false);
+    // Fixed row heights let the view skip measuring rows it does not paint
+    tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    tableView->setShowGrid(true);
+    tableView->setStyleSheet(QString(R"(        QTableView {            background: %4;            color: %1;            font-size: 16px;            border: none;            gridline-color: %2;        }        QTableView::item {            padding: 8px;            color: %1;            background: %4;        }        QTableView::item:selected {            background: %5;            color: %1;        }        QHeaderView::section {            background: %3;            color: %1;            padding: 8px;            border: none;        }    )").arg(isDarkTheme ? "#F9FAFB" : "#111827", /* Text color */ isDarkTheme ? "#4B5563" : "#D1D5DB", /* Grid color */ isDarkTheme ? "rgba(55, 65, 81, 0.95)" : "rgba(229, 231, 235, 0.95)", /* Header background */ isDarkTheme ? "rgba(31, 41, 55, 0.5)" : "rgba(255, 255, 255, 0.8)", /* Cell background */ isDarkTheme ? "rgba(139, 92, 246, 0.2)" : "rgba(139, 92, 246, 0.1)" /* Selection background */));
+
+    cardLayout->addWidget(tableView);
     centerLayout->addWidget(cardContainer);
     customLayout->addWidget(centerContainer);
     contentStack->addWidget(customContent);
@@ -98,60 +100,19 @@ void RetrievePage::setupUI()
     // Connect search
     connect(searchEdit, &QLineEdit::textChanged, this, &RetrievePage::populateTable);
     populateTable(); // Populate initially with all members
-    connect(tableWidget, &QTableWidget::cellClicked, this, &RetrievePage::handleCellClick);
+    connect(tableView, &QTableView::clicked, this, &RetrievePage::handleCellClick);
 }
 
 void RetrievePage::populateTable(const QString &filter)
 {
-    QVector<Member> allMembers = memberManager->getAllMembers();
-    QVector<Member> filteredMembers;
-
-    if (filter.trimmed().isEmpty())
-    {
-        filteredMembers = allMembers;
-    }
-    else
-    {
-        for (const Member &m : allMembers)
-        {
-            const User &u = userDataManager->getUserDataById(m.getUserId());
-            if (u.getName().contains(filter, Qt::CaseInsensitive) ||
-                u.getEmail().contains(filter, Qt::CaseInsensitive))
-            {
-                filteredMembers.append(m);
-            }
-        }
-    }
-
-    tableWidget->clearContents();
-    tableWidget->setRowCount(filteredMembers.isEmpty() ? 1 : filteredMembers.size());
-
-    if (filteredMembers.isEmpty())
+    if (filter.isNull())
     {
-        tableWidget->setItem(0, 0, new QTableWidgetItem("-"));
-        tableWidget->setItem(0, 1, new QTableWidgetItem("No data"));
-        tableWidget->setItem(0, 2, new QTableWidgetItem("-"));
+        // Explicit refresh (page shown): pick up members added or removed meanwhile
+        memberModel->refresh();
         return;
     }
 
-    for (int i = 0; i < filteredMembers.size(); ++i)
-    {
-        const Member &m = filteredMembers[i];
-        const User &u = userDataManager->getUserDataById(m.getUserId());
-
-        QTableWidgetItem *idItem = new QTableWidgetItem(QString::number(m.getId()));
-        QTableWidgetItem *nameItem = new QTableWidgetItem(u.getName());
-        QTableWidgetItem *emailItem = new QTableWidgetItem(u.getEmail());
-
-        idItem->setTextAlignment(Qt::AlignCenter);
-        nameItem->setTextAlignment(Qt::AlignCenter);
-        emailItem->setTextAlignment(Qt::AlignCenter);
-
-        tableWidget->setItem(i, 0, idItem);
-        tableWidget->setItem(i, 1, nameItem);
-        tableWidget->setItem(i, 2, emailItem);
-
-    }
+    memberModel->setFilter(filter);
 }
 
 void RetrievePage::showMessageDialog(const QString &message, bool isError)
@@ -255,17 +216,17 @@ void RetrievePage::updateTheme(bool isDark)
     }
 
     // Update table widget style if it exists
-    if (const auto table = findChild<QTableWidget *>("dataTable"))
+    if (const auto table = findChild<QTableView *>("dataTable"))
     {
         table->setStyleSheet(QString(R"(
-            QTableWidget {
+            QTableView {
                 background: transparent;
                 color: %1;
                 font-size: 16px;
                 border: none;
                 gridline-color: %2;
             }
-            QTableWidget::item {
+            QTableView::item {
                 padding: 8px;
             }
             QHeaderView::section {
@@ -293,12 +254,10 @@ void RetrievePage::handlePageChange(const QString &pageId)
         contentStack->setCurrentWidget(addMemberPage);
     }
 }
-void RetrievePage::handleCellClick(int row, int column)
+void RetrievePage::handleCellClick(const QModelIndex &index)
 {
-    QTableWidgetItem* idItem = tableWidget->item(row, 0);
-    if (!idItem) return;
-
-    int memberId = idItem->text().toInt();
+    int memberId = memberModel->memberIdAt(index.row());
+    if (memberId <= 0) return;
 
     const Member& m = memberManager->getMemberById(memberId);
     const User& u = userDataManager->getUserDataById(m.getUserId());
@@ -13,7 +13,7 @@
 #include <QPropertyAnimation>
 #include <QGraphicsOpacityEffect>
 #include <QTimer>
-#include <QTableWidget>
+#include <QTableView>
 #include <QVector>
 #include <QHeaderView>
 #include <QDebug>
@@ -21,6 +21,7 @@
 #include <QFormLayout>
 
 #include "addmemberpage.h"
+#include "membertablemodel.h"
 
 class RetrievePage : public QWidget
 {
@@ -32,7 +33,7 @@ public:
 
 private slots:
     void handlePageChange(const QString& pageId);
-    void handleCellClick(int row, int column);
+    void handleCellClick(const QModelIndex& index);
 private:
     void setupUI();
     void showMessageDialog(const QString& message, bool isError = false);
@@ -41,7 +42,8 @@ private:
     
 
     QLineEdit* searchEdit;
-    QTableWidget* tableWidget;
+    QTableView* tableView;
+    MemberTableModel* memberModel;
     UserDataManager* userDataManager;
     MemberDataManager* memberManager;
     QHBoxLayout* mainLayout;